@@ -6,10 +6,10 @@ with open("src/opcodes.h", "rt", encoding='utf-8') as f:
 	OPCODES_TEXT = f.read()
 
 pipeline = [
-	["common.h", "memory.h", "str.h", "tuplelist.h", "namedict.h", "error.h"],
-	["obj.h", "parser.h", "codeobject.h", "frame.h"],
-	["vm.h", "ref.h", "ceval.h", "compiler.h", "repl.h"],
-	["iter.h", "cffi.h", "io.h", "_generated.h", "pocketpy.h"]
+	["common.h", "memory.h", "unicode.h", "str.h", "tuplelist.h", "namedict.h", "shape.h", "error.h"],
+	["obj.h", "gc.h", "parser.h", "codeobject.h", "frame.h"],
+	["vm.h", "dict.h", "ref.h", "ceval.h", "compiler.h", "repl.h"],
+	["iter.h", "cffi.h", "io.h", "timsort.h", "_generated.h", "pocketpy.h"]
 ]
 
 copied = set()
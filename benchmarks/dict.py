@@ -0,0 +1,16 @@
+d = {}
+for i in range(100000):
+    d[i] = i
+    d[str(i)] = i
+
+total = 0
+for i in range(100000):
+    total += d[i]
+    if str(i) in d:
+        total += 1
+
+for k, v in d.items():
+    total += 1
+
+for i in range(0, 100000, 2):
+    del d[i]
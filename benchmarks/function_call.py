@@ -0,0 +1,13 @@
+def f(a, b):
+    return a
+
+class A:
+    def g(self, a):
+        return a
+
+a = A()
+x = []
+for i in range(1000000):
+    f(i, i)
+    a.g(i)
+    len(x)
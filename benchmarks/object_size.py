@@ -0,0 +1,11 @@
+import sys
+
+class A:
+    def __init__(self):
+        self.x = 1
+        self.y = 2
+
+# bytes per object, as sys.getsizeof() reports them
+print('list', sys.getsizeof([]))
+print('str', sys.getsizeof('hello'))
+print('instance', sys.getsizeof(A()))
@@ -0,0 +1,44 @@
+import time
+
+line = '2023-04-01 12:00:00 INFO [worker-7] GET /api/v1/items?page=3 status=200 ms=12'
+n = 50000
+text = '\n'.join([line] * n)
+mb = n * (len(line) + 1) / 1000000
+
+def report(name, t0):
+    dt = max(time.time() - t0, 0.000001)
+    print(name + ': ' + str(round(mb / dt, 1)) + ' MB/s')
+
+t0 = time.time()
+lines = text.split('\n')
+report('split', t0)
+assert len(lines) == n
+
+t0 = time.time()
+words = text.split()
+report('split()', t0)
+assert len(words) == n * 8
+
+t0 = time.time()
+assert text.count('status=200') == n
+report('count', t0)
+
+t0 = time.time()
+assert text.find('status=500') == -1
+report('find', t0)
+
+t0 = time.time()
+text.replace('INFO', 'WARN')
+report('replace', t0)
+
+t0 = time.time()
+text.upper()
+report('upper', t0)
+
+t0 = time.time()
+total = 0
+for l in lines:
+    head, _, tail = l.partition(' status=')
+    total += int(tail.split()[0].strip())
+report('per-line parse', t0)
+assert total == 200 * n
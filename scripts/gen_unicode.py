@@ -0,0 +1,120 @@
+# generates src/unicode.h, the case mapping tables of str.upper and str.lower,
+# from the str.upper and str.lower of the CPython that runs it
+
+import sys
+import unicodedata
+
+def code_points():
+    for cp in range(sys.maxunicode + 1):
+        if 0xD800 <= cp < 0xE000:
+            continue
+        yield cp
+
+def case_tables(f):
+    ranges = []     # [first, last, delta, stride]
+    special = []    # (cp, mapped)
+    for cp in code_points():
+        c = chr(cp)
+        r = f(c)
+        if r == c:
+            continue
+        if len(r) > 1:
+            special.append((cp, r))
+            continue
+        delta = ord(r) - cp
+        if ranges:
+            first, last, d, stride = ranges[-1]
+            step = cp - last
+            if d == delta and step in (1, 2) and (stride == 0 or stride == step):
+                ranges[-1] = [first, cp, d, step]
+                continue
+        ranges.append([cp, cp, delta, 0])
+    for r in ranges:
+        if r[3] == 0:
+            r[3] = 1
+    return ranges, special
+
+# the final sigma rule of str.lower only needs to know whether a code point is
+# case-ignorable (1), cased and not case-ignorable (2) or neither; that is read
+# from how CPython lowers a capital sigma next to it
+def sigma_kind(c):
+    a = ('A' + c + 'Σ').lower()[-1] == 'ς'
+    b = (c + 'Σ').lower()[-1] == 'ς'
+    if a and not b:
+        return 1
+    if b:
+        return 2
+    return 0
+
+def sigma_ranges():
+    ranges = []
+    for cp in code_points():
+        kind = sigma_kind(chr(cp))
+        if kind == 0:
+            continue
+        if ranges and ranges[-1][1] == cp - 1 and ranges[-1][2] == kind:
+            ranges[-1][1] = cp
+        else:
+            ranges.append([cp, cp, kind])
+    return ranges
+
+def c_string(s):
+    return '"' + ''.join('\\x%02x' % b for b in s.encode('utf-8')) + '"'
+
+def rows(items, per_line):
+    lines = []
+    for i in range(0, len(items), per_line):
+        lines.append('    ' + ' '.join(items[i:i+per_line]))
+    return '\n'.join(lines)
+
+def case_range_rows(ranges):
+    return rows(['{0x%X,0x%X,%d,%d},' % tuple(r) for r in ranges], 4)
+
+def special_rows(special):
+    return rows(['{0x%X,%s},' % (cp, c_string(s)) for cp, s in special], 3)
+
+upper, upper_special = case_tables(str.upper)
+lower, lower_special = case_tables(str.lower)
+sigma = sigma_ranges()
+
+text = f'''#pragma once
+
+// generated by scripts/gen_unicode.py from the str.upper and str.lower of
+// CPython {sys.version_info[0]}.{sys.version_info[1]} (Unicode {unicodedata.unidata_version}), do not edit
+
+#include "common.h"
+
+namespace pkpy {{
+
+// the code points first, first+stride, ... up to last map to themselves plus delta
+struct UnicodeCaseRange {{ uint32_t first; uint32_t last; int32_t delta; uint32_t stride; }};
+// a code point that maps to more than one, `mapped` is UTF-8
+struct UnicodeCaseSpecial {{ uint32_t cp; const char* mapped; }};
+// kind is 1 for case-ignorable code points and 2 for cased ones that are not case-ignorable
+struct UnicodeKindRange {{ uint32_t first; uint32_t last; uint32_t kind; }};
+
+const UnicodeCaseRange kUnicodeUpper[] = {{
+{case_range_rows(upper)}
+}};
+
+const UnicodeCaseSpecial kUnicodeUpperSpecial[] = {{
+{special_rows(upper_special)}
+}};
+
+const UnicodeCaseRange kUnicodeLower[] = {{
+{case_range_rows(lower)}
+}};
+
+const UnicodeCaseSpecial kUnicodeLowerSpecial[] = {{
+{special_rows(lower_special)}
+}};
+
+const UnicodeKindRange kUnicodeSigmaKind[] = {{
+{rows(['{0x%X,0x%X,%d},' % tuple(r) for r in sigma], 5)}
+}};
+
+}} // namespace pkpy
+'''
+
+with open('src/unicode.h', 'wt', encoding='utf-8', newline='\n') as f:
+    f.write(text)
@@ -1,350 +1,798 @@
 #pragma once
 
 #include "vm.h"
+#include "dict.h"
 #include "ref.h"
 
 namespace pkpy{
 
 Str _read_file_cwd(const Str& name, bool* ok);
+inline PyVarOrNull _range_iter_next(BaseIter* it);     // iter.h
+
+inline bool _mul_overflow(i64 a, i64 b, i64* out){
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_mul_overflow(a, b, out);
+#else
+    if(a != 0 && b != 0){
+        i64 abs_a = a < 0 ? -a : a;     // tagged ints never hold the minimum value
+        i64 abs_b = b < 0 ? -b : b;
+        if(abs_a > std::numeric_limits<i64>::max() / abs_b) return true;
+    }
+    *out = a * b;
+    return false;
+#endif
+}
+
+// these mirror the int/float builtins for tagged operands and return nullptr when the
+// special method protocol must be used instead (e.g. user types or unsupported ops)
+inline PyVarOrNull VM::_fast_binary_op(int op, const PyVar& lhs, const PyVar& rhs){
+    if(is_both_int(lhs, rhs)){
+        i64 a = _CAST(i64, lhs);
+        i64 b = _CAST(i64, rhs);
+        switch(op){
+            case 0: return VAR(a + b);      // cannot overflow i64, VAR checks the tag range
+            case 1: return VAR(a - b);
+            case 2: {
+                i64 ret;
+                if(_mul_overflow(a, b, &ret)) _error("OverflowError", "integer multiplication out of range");
+                return VAR(ret);
+            }
+            case 3: if(b == 0) ZeroDivisionError(); return VAR((f64)a / (f64)b);
+            case 4: if(b == 0) ZeroDivisionError(); return VAR(a / b);
+            case 5: if(b == 0) ZeroDivisionError(); return VAR(a % b);
+            default: return nullptr;
+        }
+    }
+    if(is_both_int_or_float(lhs, rhs)){
+        f64 a = is_int(lhs) ? (f64)_CAST(i64, lhs) : _CAST(f64, lhs);
+        f64 b = is_int(rhs) ? (f64)_CAST(i64, rhs) : _CAST(f64, rhs);
+        switch(op){
+            case 0: return VAR(a + b);
+            case 1: return VAR(a - b);
+            case 2: return VAR(a * b);
+            case 3: if(b == 0) ZeroDivisionError(); return VAR(a / b);
+            default: return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+inline PyVarOrNull VM::_fast_bitwise_op(int op, const PyVar& lhs, const PyVar& rhs){
+    if(!is_both_int(lhs, rhs)) return nullptr;
+    i64 a = _CAST(i64, lhs);
+    i64 b = _CAST(i64, rhs);
+    switch(op){
+        case 0: return VAR(a << b);
+        case 1: return VAR(a >> b);
+        case 2: return VAR(a & b);
+        case 3: return VAR(a | b);
+        case 4: return VAR(a ^ b);
+        default: return nullptr;
+    }
+}
+
+// `op` indexes CMP_SPECIAL_METHODS
+template<typename T>
+inline bool _compare_op(int op, T a, T b){
+    switch(op){
+        case 0: return a < b;
+        case 1: return a <= b;
+        case 2: return a == b;
+        case 3: return a != b;
+        case 4: return a > b;
+        case 5: return a >= b;
+        default: UNREACHABLE();
+    }
+}
+
+inline PyVarOrNull VM::_fast_compare_op(int op, const PyVar& lhs, const PyVar& rhs){
+    if(is_both_int(lhs, rhs)){
+        return VAR(_compare_op(op, _CAST(i64, lhs), _CAST(i64, rhs)));
+    }
+    if(is_both_int_or_float(lhs, rhs)){
+        f64 a = is_int(lhs) ? (f64)_CAST(i64, lhs) : _CAST(f64, lhs);
+        f64 b = is_int(rhs) ? (f64)_CAST(i64, rhs) : _CAST(f64, rhs);
+        return VAR(_compare_op(op, a, b));
+    }
+    return nullptr;
+}
+
+// the variable that the store following an in-place op writes its result to, or nullptr
+inline PyVar* VM::_inplace_target_slot(Frame* frame){
+    const Bytecode& next = frame->co->codes[frame->_ip + 1];
+    switch(next.op){
+        case OP_STORE_FAST: return &frame->_fast_locals[next.arg];
+        case OP_STORE_NAME: return NameRef(frame->co->names[next.arg]).try_get_slot(frame);
+        default: return nullptr;
+    }
+}
+
+inline bool _is_exact_args_call(const Function& fn, int argc){
+    const CodeObject* co = fn.code.get();
+    return co->use_fast_locals && !co->is_generator && fn.starred_arg.empty() &&
+        fn.kwargs_order.empty() && fn.args.size() == argc;
+}
+
+// picks the specialized form of a warm generic instruction for the operands it sees now,
+// or OP_NO_OP if there is none; the specialized handlers re-check the same conditions
+inline Opcode VM::_specialize(Frame* frame, const Bytecode& byte, const PyVar& a, const PyVar& b){
+    switch(byte.op){
+        case OP_BINARY_OP:
+            if(is_both_int(a, b)){
+                if(byte.arg == 0) return OP_BINARY_ADD_INT;
+                if(byte.arg == 1) return OP_BINARY_SUB_INT;
+                if(byte.arg == 2) return OP_BINARY_MUL_INT;
+            }else if(is_float(a) && is_float(b)){
+                if(byte.arg == 0) return OP_BINARY_ADD_FLOAT;
+                if(byte.arg == 1) return OP_BINARY_SUB_FLOAT;
+                if(byte.arg == 2) return OP_BINARY_MUL_FLOAT;
+            }
+            return OP_NO_OP;
+        case OP_COMPARE_OP:
+            if(is_both_int(a, b)) return OP_COMPARE_OP_INT;
+            if(is_float(a) && is_float(b)) return OP_COMPARE_OP_FLOAT;
+            return OP_NO_OP;
+        case OP_BUILD_ATTR: {
+            const InlineCache& c = frame->co->inline_caches[frame->_ip];
+            if(a.is_tagged() || !(a->has_shape() || a->is_attr_valid())) return OP_NO_OP;
+            if(c.kind != CACHE_ATTR_INSTANCE || c.key != _t(a).get() || c.version != _t(a)->attr()._version) return OP_NO_OP;
+            return OP_BUILD_ATTR_INSTANCE;
+        }
+        case OP_BUILD_INDEX:
+            if(is_type(a, tp_list) && is_int(b)) return OP_INDEX_LIST_INT;
+            return OP_NO_OP;
+        case OP_CALL:
+            if(is_type(a, tp_function) && _is_exact_args_call(OBJ_GET(Function, a), byte.arg)) return OP_CALL_PY_EXACT_ARGS;
+            return OP_NO_OP;
+        case OP_FOR_ITER: {
+            const PyVar& ref = PyIter_AS_C(a)->ref();
+            if(ref != nullptr && is_type(ref, tp_range)) return OP_FOR_ITER_RANGE;
+            return OP_NO_OP;
+        }
+        default: return OP_NO_OP;
+    }
+}
 
 PyVar VM::run_frame(Frame* frame){
-    while(frame->has_next_bytecode()){
-        const Bytecode& byte = frame->next_bytecode();
+    // every CodeObject ends with OP_END_OF_CODE, so the loop needs no bounds check
+#if PK_ENABLE_COMPUTED_GOTO
+    static void* OP_LABELS[] = {
+        #define OPCODE(name) &&CASE_OP_##name,
+        #include "opcodes.h"
+        #undef OPCODE
+    };
+    #define TARGET(op) CASE_OP_##op:
+    #define DISPATCH() { byte = frame->next_bytecode(); goto *OP_LABELS[byte.op]; }
+    Bytecode byte;
+    DISPATCH();
+    {
+#else
+    #define TARGET(op) case OP_##op:
+    #define DISPATCH() continue
+    while(true){
+        Bytecode byte = frame->next_bytecode();
         switch (byte.op)
         {
-        case OP_NO_OP: continue;
-        case OP_SETUP_DECORATOR: continue;
-        case OP_LOAD_CONST: frame->push(frame->co->consts[byte.arg]); continue;
-        case OP_LOAD_FUNCTION: {
-            const PyVar obj = frame->co->consts[byte.arg];
-            Function f = CAST(Function, obj);  // copy
-            f._module = frame->_module;
-            frame->push(VAR(f));
-        } continue;
-        case OP_SETUP_CLOSURE: {
-            Function& f = CAST(Function&, frame->top());    // reference
-            f._closure = frame->_locals;
-        } continue;
-        case OP_LOAD_NAME_REF: {
-            frame->push(PyRef(NameRef(frame->co->names[byte.arg])));
-        } continue;
-        case OP_LOAD_NAME: {
-            frame->push(NameRef(frame->co->names[byte.arg]).get(this, frame));
-        } continue;
-        case OP_STORE_NAME: {
-            auto& p = frame->co->names[byte.arg];
-            NameRef(p).set(this, frame, frame->pop());
-        } continue;
-        case OP_BUILD_ATTR_REF: case OP_BUILD_ATTR: {
-            auto& attr = frame->co->names[byte.arg];
-            PyVar obj = frame->pop_value(this);
-            AttrRef ref = AttrRef(obj, NameRef(attr));
-            if(byte.op == OP_BUILD_ATTR) frame->push(ref.get(this, frame));
-            else frame->push(PyRef(ref));
-        } continue;
-        case OP_BUILD_INDEX: {
-            PyVar index = frame->pop_value(this);
-            auto ref = IndexRef(frame->pop_value(this), index);
-            if(byte.arg > 0) frame->push(ref.get(this, frame));
-            else frame->push(PyRef(ref));
-        } continue;
-        case OP_FAST_INDEX: case OP_FAST_INDEX_REF: {
-            auto& a = frame->co->names[byte.arg & 0xFFFF];
-            auto& x = frame->co->names[(byte.arg >> 16) & 0xFFFF];
-            auto ref = IndexRef(NameRef(a).get(this, frame), NameRef(x).get(this, frame));
-            if(byte.op == OP_FAST_INDEX) frame->push(ref.get(this, frame));
-            else frame->push(PyRef(ref));
-        } continue;
-        case OP_ROT_TWO: ::std::swap(frame->top(), frame->top_1()); continue;
-        case OP_STORE_REF: {
-            // PyVar obj = frame->pop_value(this);
-            // PyVarRef r = frame->pop();
-            // PyRef_AS_C(r)->set(this, frame, std::move(obj));
-            PyRef_AS_C(frame->top_1())->set(this, frame, frame->top_value(this));
-            frame->_pop(); frame->_pop();
-        } continue;
-        case OP_DELETE_REF: 
-            PyRef_AS_C(frame->top())->del(this, frame);
-            frame->_pop();
-            continue;
-        case OP_BUILD_TUPLE: {
-            Args items = frame->pop_n_values_reversed(this, byte.arg);
-            frame->push(VAR(std::move(items)));
-        } continue;
-        case OP_BUILD_TUPLE_REF: {
-            Args items = frame->pop_n_reversed(byte.arg);
-            frame->push(PyRef(TupleRef(std::move(items))));
-        } continue;
-        case OP_BUILD_STRING: {
-            Args items = frame->pop_n_values_reversed(this, byte.arg);
-            StrStream ss;
-            for(int i=0; i<items.size(); i++) ss << CAST(Str, asStr(items[i]));
-            frame->push(VAR(ss.str()));
-        } continue;
-        case OP_LOAD_EVAL_FN: frame->push(builtins->attr(m_eval)); continue;
-        case OP_BEGIN_CLASS: {
-            auto& name = frame->co->names[byte.arg];
-            PyVar clsBase = frame->pop_value(this);
-            if(clsBase == None) clsBase = _t(tp_object);
-            check_type(clsBase, tp_type);
-            PyVar cls = new_type_object(frame->_module, name.first, OBJ_GET(Type, clsBase));
-            frame->push(cls);
-        } continue;
-        case OP_END_CLASS: {
-            PyVar cls = frame->pop();
-            cls->attr()._try_perfect_rehash();
-        }; continue;
-        case OP_STORE_CLASS_ATTR: {
-            auto& name = frame->co->names[byte.arg];
-            PyVar obj = frame->pop_value(this);
-            PyVar& cls = frame->top();
-            cls->attr().set(name.first, std::move(obj));
-        } continue;
-        case OP_RETURN_VALUE: return frame->pop_value(this);
-        case OP_PRINT_EXPR: {
-            const PyVar expr = frame->top_value(this);
-            if(expr != None) *_stdout << CAST(Str, asRepr(expr)) << '\n';
-        } continue;
-        case OP_POP_TOP: frame->_pop(); continue;
-        case OP_BINARY_OP: {
+#endif
+    // adaptive quickening: a warm generic instruction rewrites itself into a specialized form,
+    // which turns back into the generic form and re-runs when its guard fails
+    #define QUICKEN_WARM() (++frame->co->inline_caches[frame->_ip].counter == kQuickenWarmup)
+    #define QUICKEN(a, b) {                                                     \
+        Opcode _op = _specialize(frame, byte, a, b);                            \
+        if(_op != OP_NO_OP) frame->co->codes[frame->_ip].op = _op;              \
+        else frame->co->inline_caches[frame->_ip].counter = -kQuickenBackoff;   \
+    }
+    #define DEOPT(generic_op) {                                                 \
+        frame->co->codes[frame->_ip].op = OP_##generic_op;                      \
+        frame->co->inline_caches[frame->_ip].counter = -kQuickenBackoff;        \
+        frame->_next_ip = frame->_ip;                                           \
+        DISPATCH();                                                             \
+    }
+    // raises a Python exception without C++ unwinding, the caller frames are handled by _exec()
+    #define RAISE_IN_FRAME(e) {                                                 \
+        frame->push(VAR(e));                                                    \
+        if(frame->jump_to_exception_handler()) DISPATCH();                      \
+        return _py_op_raise;                                                    \
+    }
+    TARGET(NO_OP) DISPATCH();
+    TARGET(SETUP_DECORATOR) DISPATCH();
+    TARGET(LOAD_CONST) frame->push(frame->co->consts[byte.arg]); DISPATCH();
+    TARGET(LOAD_FUNCTION) {
+        const PyVar obj = frame->co->consts[byte.arg];
+        Function f = CAST(Function, obj);  // copy
+        f._module = frame->_module;
+        frame->push(VAR(f));
+    } DISPATCH();
+    TARGET(SETUP_CLOSURE) {
+        Function& f = CAST(Function&, frame->top());    // reference
+        f._closure = frame->_locals;
+    } DISPATCH();
+    TARGET(LOAD_NAME_REF) {
+        frame->push(PyRef(NameRef(frame->co->names[byte.arg])));
+    } DISPATCH();
+    TARGET(LOAD_NAME) {
+        // without locals or closure dicts only globals and builtins are probed, which can be cached
+        if(frame->_locals != nullptr || frame->_closure != nullptr){
+            frame->push(NameRef(frame->co->names[byte.arg]).get_from_dicts(this, frame));
+            DISPATCH();
+        }
+        InlineCache& c = frame->co->inline_caches[frame->_ip];
+        NameDict& globals = frame->f_globals();
+        NameDict& b = builtins->attr();
+        if(c.key != &globals || c.version != globals._version || c.version_2 != b._version){
+            StrName name = frame->co->names[byte.arg].first;
+            PyVar* val = globals.try_get(name);
+            if(val == nullptr) val = b.try_get(name);
+            if(val == nullptr) NameError(name);
+            c.key = &globals;
+            c.version = globals._version;
+            c.version_2 = b._version;
+            c.value = val;
+        }
+        frame->push(*c.value);
+    } DISPATCH();
+    TARGET(LOAD_FAST) {
+        const PyVar& val = frame->_fast_locals[byte.arg];
+        // an unbound local falls back to closure, globals and builtins
+        if(val != nullptr) frame->push(val);
+        else frame->push(NameRef({frame->co->varnames[byte.arg], NAME_LOCAL}).get(this, frame));
+    } DISPATCH();
+    TARGET(STORE_FAST) frame->_fast_locals[byte.arg] = frame->pop(); DISPATCH();
+    TARGET(STORE_NAME) {
+        auto& p = frame->co->names[byte.arg];
+        NameRef(p).set(this, frame, frame->pop());
+    } DISPATCH();
+    TARGET(BUILD_ATTR) {
+        StrName name = frame->co->names[byte.arg].first;
+        PyVar obj = frame->pop_value(this);
+        frame->push(getattr(obj, name, frame->co->inline_caches[frame->_ip]));
+        if(QUICKEN_WARM()) QUICKEN(obj, obj);
+    } DISPATCH();
+    TARGET(LOAD_METHOD) {
+        StrName name = frame->co->names[byte.arg].first;
+        PyVar obj = frame->pop_value(this);
+        PyVar self = nullptr;
+        frame->push(get_unbound_method(obj, name, &self, frame->co->inline_caches[frame->_ip]));
+        frame->push(std::move(self));
+    } DISPATCH();
+    TARGET(BUILD_ATTR_REF) {
+        auto& attr = frame->co->names[byte.arg];
+        PyVar obj = frame->pop_value(this);
+        frame->push(PyRef(AttrRef(obj, NameRef(attr))));
+    } DISPATCH();
+    TARGET(BUILD_INDEX) {
+        PyVar index = frame->pop_value(this);
+        PyVar obj = frame->pop_value(this);
+        if(byte.arg > 0 && QUICKEN_WARM()) QUICKEN(obj, index);
+        auto ref = IndexRef(std::move(obj), index);
+        if(byte.arg > 0) frame->push(ref.get(this, frame));
+        else frame->push(PyRef(ref));
+    } DISPATCH();
+    TARGET(FAST_INDEX) {
+        auto& a = frame->co->names[byte.arg & 0xFFFF];
+        auto& x = frame->co->names[(byte.arg >> 16) & 0xFFFF];
+        auto ref = IndexRef(NameRef(a).get_from_dicts(this, frame), NameRef(x).get_from_dicts(this, frame));
+        frame->push(ref.get(this, frame));
+    } DISPATCH();
+    TARGET(ROT_TWO) ::std::swap(frame->top(), frame->top_1()); DISPATCH();
+    TARGET(STORE_REF) {
+        // PyVar obj = frame->pop_value(this);
+        // PyVarRef r = frame->pop();
+        // PyRef_AS_C(r)->set(this, frame, std::move(obj));
+        PyRef_AS_C(frame->top_1())->set(this, frame, frame->top_value_ref(this));
+        frame->_pop(); frame->_pop();
+    } DISPATCH();
+    TARGET(STORE_ATTR) {
+        StrName name = frame->co->names[byte.arg].first;
+        PyVar value = frame->pop_value(this);
+        PyVar obj = frame->pop_value(this);
+        setattr(obj, name, std::move(value), frame->co->inline_caches[frame->_ip]);
+    } DISPATCH();
+    TARGET(STORE_SUBSCR) {
+        Args args(3);
+        args[2] = frame->pop_value(this);
+        args[1] = frame->pop_value(this);
+        args[0] = frame->pop_value(this);
+        fast_call(__setitem__, std::move(args));
+    } DISPATCH();
+    TARGET(DELETE_NAME) {
+        auto& p = frame->co->names[byte.arg];
+        NameRef(p).del(this, frame);
+    } DISPATCH();
+    TARGET(DELETE_FAST) {
+        PyVar& val = frame->_fast_locals[byte.arg];
+        StrName name = frame->co->varnames[byte.arg];
+        if(val == nullptr) NameError(name);
+        val.reset();
+        if(frame->_locals != nullptr && frame->_locals->contains(name)) frame->_locals->erase(name);
+    } DISPATCH();
+    TARGET(DELETE_ATTR) {
+        StrName name = frame->co->names[byte.arg].first;
+        PyVar obj = frame->pop_value(this);
+        delattr(obj, name);
+    } DISPATCH();
+    TARGET(DELETE_SUBSCR) {
+        PyVar index = frame->pop_value(this);
+        PyVar obj = frame->pop_value(this);
+        fast_call(__delitem__, two_args(std::move(obj), std::move(index)));
+    } DISPATCH();
+    TARGET(DELETE_REF) 
+        PyRef_AS_C(frame->top())->del(this, frame);
+        frame->_pop();
+        DISPATCH();
+    TARGET(BUILD_TUPLE) {
+        Args items = frame->pop_n_values_reversed(this, byte.arg);
+        frame->push(VAR(std::move(items)));
+    } DISPATCH();
+    TARGET(BUILD_TUPLE_REF) {
+        Args items = frame->pop_n_reversed(byte.arg);
+        frame->push(PyRef(TupleRef(std::move(items))));
+    } DISPATCH();
+    TARGET(UNPACK_SEQUENCE) {
+        PyVar obj = frame->pop_value(this);
+        if(is_type(obj, tp_tuple) || is_type(obj, tp_list)){
+            const Tuple* t = is_type(obj, tp_tuple) ? &_CAST(Tuple&, obj) : nullptr;
+            const List* l = t == nullptr ? &_CAST(List&, obj) : nullptr;
+            int size = t != nullptr ? t->size() : l->size();
+            if(size < byte.arg) ValueError("not enough values to unpack");
+            if(size > byte.arg) ValueError("too many values to unpack");
+            for(int i=size-1; i>=0; i--) frame->push(t != nullptr ? (*t)[i] : (*l)[i]);
+        }else{
+            PyVar iter_obj = asIter(obj);
+            BaseIter* iter = PyIter_AS_C(iter_obj);
+            List items;
+            PyVarOrNull x;
+            while(items.size() <= byte.arg && (x = iter->next()) != nullptr) items.push_back(x);
+            if(items.size() < byte.arg) ValueError("not enough values to unpack");
+            if(items.size() > byte.arg) ValueError("too many values to unpack");
+            for(int i=items.size()-1; i>=0; i--) frame->push(std::move(items[i]));
+        }
+    } DISPATCH();
+    TARGET(BUILD_STRING) {
+        Args items = frame->pop_n_values_reversed(this, byte.arg);
+        StrStream ss;
+        for(int i=0; i<items.size(); i++) ss << CAST(Str, asStr(items[i]));
+        frame->push(VAR(ss.str()));
+    } DISPATCH();
+    TARGET(LOAD_EVAL_FN) frame->push(builtins->attr(m_eval)); DISPATCH();
+    TARGET(BEGIN_CLASS) {
+        auto& name = frame->co->names[byte.arg];
+        PyVar clsBase = frame->pop_value(this);
+        if(clsBase == None) clsBase = _t(tp_object);
+        check_type(clsBase, tp_type);
+        PyVar cls = new_type_object(frame->_module, name.first, OBJ_GET(Type, clsBase));
+        frame->push(cls);
+    } DISPATCH();
+    TARGET(END_CLASS) {
+        PyVar cls = frame->pop();
+        cls->attr()._try_perfect_rehash();
+    } DISPATCH();
+    TARGET(STORE_CLASS_ATTR) {
+        auto& name = frame->co->names[byte.arg];
+        PyVar obj = frame->pop_value(this);
+        PyVar& cls = frame->top();
+        cls->attr().set(name.first, std::move(obj));
+    } DISPATCH();
+    TARGET(RETURN_VALUE) return frame->pop_value(this);
+    TARGET(PRINT_EXPR) {
+        const PyVar& expr = frame->top_value_ref(this);
+        if(expr != None) *_stdout << CAST(Str, asRepr(expr)) << '\n';
+    } DISPATCH();
+    TARGET(POP_TOP) frame->_pop(); DISPATCH();
+    TARGET(BINARY_OP) {
+        PyVar rhs = frame->pop_value(this);
+        PyVar& lhs = frame->top_value_ref(this);
+        if(QUICKEN_WARM()) QUICKEN(lhs, rhs);
+        PyVarOrNull ret = _fast_binary_op(byte.arg, lhs, rhs);
+        if(ret == nullptr){
             Args args(2);
-            args[1] = frame->pop_value(this);
-            args[0] = frame->top_value(this);
-            frame->top() = fast_call(BINARY_SPECIAL_METHODS[byte.arg], std::move(args));
-        } continue;
-        case OP_BITWISE_OP: {
+            args[0] = std::move(lhs);
+            args[1] = std::move(rhs);
+            ret = fast_call(BINARY_SPECIAL_METHODS[byte.arg], std::move(args));
+        }
+        frame->top() = std::move(ret);
+    } DISPATCH();
+    TARGET(BITWISE_OP) {
+        PyVar rhs = frame->pop_value(this);
+        PyVar& lhs = frame->top_value_ref(this);
+        PyVarOrNull ret = _fast_bitwise_op(byte.arg, lhs, rhs);
+        if(ret == nullptr){
             Args args(2);
-            args[1] = frame->pop_value(this);
-            args[0] = frame->top_value(this);
-            frame->top() = fast_call(BITWISE_SPECIAL_METHODS[byte.arg], std::move(args));
-        } continue;
-        case OP_INPLACE_BINARY_OP: {
+            args[0] = std::move(lhs);
+            args[1] = std::move(rhs);
+            ret = fast_call(BITWISE_SPECIAL_METHODS[byte.arg], std::move(args));
+        }
+        frame->top() = std::move(ret);
+    } DISPATCH();
+    // the compiler loads the target before and stores it after these
+    TARGET(INPLACE_BINARY_OP) {
+        PyVar rhs = frame->pop_value(this);
+        PyVar& lhs = frame->top_value_ref(this);
+        // `s += x` appends to s when the variable and the stack slot hold its only references
+        bool in_place = false;
+        if(byte.arg == 0 && lhs.use_count() == 2 && is_type(lhs, tp_str) && is_type(rhs, tp_str)){
+            PyVar* slot = _inplace_target_slot(frame);
+            in_place = slot != nullptr && *slot == lhs;
+        }
+        if(in_place) OBJ_GET(Str, lhs)._inplace_append(OBJ_GET(Str, rhs));
+        PyVarOrNull ret = in_place ? std::move(lhs) : _fast_binary_op(byte.arg, lhs, rhs);
+        if(ret == nullptr){
+            PyVar* f = find_name_in_mro(_t(lhs).get(), BINARY_INPLACE_SPECIAL_METHODS[byte.arg]);
             Args args(2);
-            args[1] = frame->pop();
-            args[0] = frame->top_value(this);
-            PyVar ret = fast_call(BINARY_SPECIAL_METHODS[byte.arg], std::move(args));
-            PyRef_AS_C(frame->top())->set(this, frame, std::move(ret));
-            frame->_pop();
-        } continue;
-        case OP_INPLACE_BITWISE_OP: {
+            args[0] = std::move(lhs);
+            args[1] = std::move(rhs);
+            if(f != nullptr) ret = call(*f, std::move(args));
+            else ret = fast_call(BINARY_SPECIAL_METHODS[byte.arg], std::move(args));
+        }
+        frame->top() = std::move(ret);
+    } DISPATCH();
+    TARGET(INPLACE_BITWISE_OP) {
+        PyVar rhs = frame->pop_value(this);
+        PyVar& lhs = frame->top_value_ref(this);
+        PyVarOrNull ret = _fast_bitwise_op(byte.arg, lhs, rhs);
+        if(ret == nullptr){
+            PyVar* f = find_name_in_mro(_t(lhs).get(), BITWISE_INPLACE_SPECIAL_METHODS[byte.arg]);
             Args args(2);
-            args[1] = frame->pop_value(this);
-            args[0] = frame->top_value(this);
-            PyVar ret = fast_call(BITWISE_SPECIAL_METHODS[byte.arg], std::move(args));
-            PyRef_AS_C(frame->top())->set(this, frame, std::move(ret));
-            frame->_pop();
-        } continue;
-        case OP_COMPARE_OP: {
+            args[0] = std::move(lhs);
+            args[1] = std::move(rhs);
+            if(f != nullptr) ret = call(*f, std::move(args));
+            else ret = fast_call(BITWISE_SPECIAL_METHODS[byte.arg], std::move(args));
+        }
+        frame->top() = std::move(ret);
+    } DISPATCH();
+    TARGET(COMPARE_OP) {
+        PyVar rhs = frame->pop_value(this);
+        PyVar& lhs = frame->top_value_ref(this);
+        if(QUICKEN_WARM()) QUICKEN(lhs, rhs);
+        PyVarOrNull ret = _fast_compare_op(byte.arg, lhs, rhs);
+        if(ret == nullptr){
             Args args(2);
-            args[1] = frame->pop_value(this);
-            args[0] = frame->top_value(this);
-            frame->top() = fast_call(CMP_SPECIAL_METHODS[byte.arg], std::move(args));
-        } continue;
-        case OP_IS_OP: {
-            PyVar rhs = frame->pop_value(this);
-            bool ret_c = rhs == frame->top_value(this);
-            if(byte.arg == 1) ret_c = !ret_c;
-            frame->top() = VAR(ret_c);
-        } continue;
-        case OP_CONTAINS_OP: {
-            PyVar rhs = frame->pop_value(this);
-            bool ret_c = CAST(bool, call(rhs, __contains__, one_arg(frame->pop_value(this))));
-            if(byte.arg == 1) ret_c = !ret_c;
-            frame->push(VAR(ret_c));
-        } continue;
-        case OP_UNARY_NEGATIVE:
-            frame->top() = num_negated(frame->top_value(this));
-            continue;
-        case OP_UNARY_NOT: {
-            PyVar obj = frame->pop_value(this);
-            const PyVar& obj_bool = asBool(obj);
-            frame->push(VAR(!_CAST(bool, obj_bool)));
-        } continue;
-        case OP_POP_JUMP_IF_FALSE:
-            if(!_CAST(bool, asBool(frame->pop_value(this)))) frame->jump_abs(byte.arg);
-            continue;
-        case OP_LOAD_NONE: frame->push(None); continue;
-        case OP_LOAD_TRUE: frame->push(True); continue;
-        case OP_LOAD_FALSE: frame->push(False); continue;
-        case OP_LOAD_ELLIPSIS: frame->push(Ellipsis); continue;
-        case OP_ASSERT: {
-            PyVar _msg = frame->pop_value(this);
-            Str msg = CAST(Str, asStr(_msg));
-            PyVar expr = frame->pop_value(this);
-            if(asBool(expr) != True) _error("AssertionError", msg);
-        } continue;
-        case OP_EXCEPTION_MATCH: {
-            const auto& e = CAST(Exception&, frame->top());
-            StrName name = frame->co->names[byte.arg].first;
-            frame->push(VAR(e.match_type(name)));
-        } continue;
-        case OP_RAISE: {
-            PyVar obj = frame->pop_value(this);
-            Str msg = obj == None ? "" : CAST(Str, asStr(obj));
-            StrName type = frame->co->names[byte.arg].first;
-            _error(type, msg);
-        } continue;
-        case OP_RE_RAISE: _raise(); continue;
-        case OP_BUILD_LIST:
-            frame->push(VAR(frame->pop_n_values_reversed(this, byte.arg).move_to_list()));
-            continue;
-        case OP_BUILD_MAP: {
-            Args items = frame->pop_n_values_reversed(this, byte.arg*2);
-            PyVar obj = call(builtins->attr("dict"));
-            for(int i=0; i<items.size(); i+=2){
-                call(obj, __setitem__, two_args(items[i], items[i+1]));
-            }
-            frame->push(obj);
-        } continue;
-        case OP_BUILD_SET: {
-            PyVar list = VAR(
-                frame->pop_n_values_reversed(this, byte.arg).move_to_list()
-            );
-            PyVar obj = call(builtins->attr("set"), one_arg(list));
-            frame->push(obj);
-        } continue;
-        case OP_LIST_APPEND: {
-            PyVar obj = frame->pop_value(this);
-            List& list = CAST(List&, frame->top_1());
-            list.push_back(std::move(obj));
-        } continue;
-        case OP_MAP_ADD: {
-            PyVar value = frame->pop_value(this);
-            PyVar key = frame->pop_value(this);
-            call(frame->top_1(), __setitem__, two_args(key, value));
-        } continue;
-        case OP_SET_ADD: {
-            PyVar obj = frame->pop_value(this);
-            call(frame->top_1(), "add", one_arg(obj));
-        } continue;
-        case OP_DUP_TOP_VALUE: frame->push(frame->top_value(this)); continue;
-        case OP_UNARY_STAR: {
-            if(byte.arg > 0){   // rvalue
-                frame->top() = VAR(StarWrapper(frame->top_value(this), true));
-            }else{
-                PyRef_AS_C(frame->top()); // check ref
-                frame->top() = VAR(StarWrapper(frame->top(), false));
-            }
-        } continue;
-        case OP_CALL_KWARGS_UNPACK: case OP_CALL_KWARGS: {
-            int ARGC = byte.arg & 0xFFFF;
-            int KWARGC = (byte.arg >> 16) & 0xFFFF;
-            Args kwargs = frame->pop_n_values_reversed(this, KWARGC*2);
-            Args args = frame->pop_n_values_reversed(this, ARGC);
-            if(byte.op == OP_CALL_KWARGS_UNPACK) unpack_args(args);
-            PyVar callable = frame->pop_value(this);
-            PyVar ret = call(callable, std::move(args), kwargs, true);
-            if(ret == _py_op_call) return ret;
-            frame->push(std::move(ret));
-        } continue;
-        case OP_CALL_UNPACK: case OP_CALL: {
-            Args args = frame->pop_n_values_reversed(this, byte.arg);
-            if(byte.op == OP_CALL_UNPACK) unpack_args(args);
-            PyVar callable = frame->pop_value(this);
-            PyVar ret = call(callable, std::move(args), no_arg(), true);
-            if(ret == _py_op_call) return ret;
-            frame->push(std::move(ret));
-        } continue;
-        case OP_JUMP_ABSOLUTE: frame->jump_abs(byte.arg); continue;
-        case OP_SAFE_JUMP_ABSOLUTE: frame->jump_abs_safe(byte.arg); continue;
-        case OP_GOTO: {
-            StrName label = frame->co->names[byte.arg].first;
-            auto it = frame->co->labels.find(label);
-            if(it == frame->co->labels.end()) _error("KeyError", "label " + label.str().escape(true) + " not found");
-            frame->jump_abs_safe(it->second);
-        } continue;
-        case OP_GET_ITER: {
-            PyVar obj = frame->pop_value(this);
-            PyVar iter = asIter(obj);
-            check_type(frame->top(), tp_ref);
-            PyIter_AS_C(iter)->loop_var = frame->pop();
-            frame->push(std::move(iter));
-        } continue;
-        case OP_FOR_ITER: {
-            BaseIter* it = PyIter_AS_C(frame->top());
-            PyVar obj = it->next();
-            if(obj != nullptr){
-                PyRef_AS_C(it->loop_var)->set(this, frame, std::move(obj));
-            }else{
-                int blockEnd = frame->co->blocks[byte.block].end;
-                frame->jump_abs_safe(blockEnd);
-            }
-        } continue;
-        case OP_LOOP_CONTINUE: {
-            int blockStart = frame->co->blocks[byte.block].start;
-            frame->jump_abs(blockStart);
-        } continue;
-        case OP_LOOP_BREAK: {
+            args[0] = std::move(lhs);
+            args[1] = std::move(rhs);
+            ret = fast_call(CMP_SPECIAL_METHODS[byte.arg], std::move(args));
+        }
+        frame->top() = std::move(ret);
+    } DISPATCH();
+    TARGET(IS_OP) {
+        PyVar rhs = frame->pop_value(this);
+        bool ret_c = rhs == frame->top_value_ref(this);
+        if(byte.arg == 1) ret_c = !ret_c;
+        frame->top() = VAR(ret_c);
+    } DISPATCH();
+    TARGET(CONTAINS_OP) {
+        PyVar rhs = frame->pop_value(this);
+        bool ret_c = CAST(bool, call(rhs, __contains__, one_arg(frame->pop_value(this))));
+        if(byte.arg == 1) ret_c = !ret_c;
+        frame->push(VAR(ret_c));
+    } DISPATCH();
+    TARGET(UNARY_NEGATIVE)
+        frame->top() = num_negated(frame->top_value_ref(this));
+        DISPATCH();
+    TARGET(UNARY_NOT) {
+        PyVar obj = frame->pop_value(this);
+        const PyVar& obj_bool = asBool(obj);
+        frame->push(VAR(!_CAST(bool, obj_bool)));
+    } DISPATCH();
+    TARGET(POP_JUMP_IF_FALSE)
+        if(!_CAST(bool, asBool(frame->pop_value(this)))) frame->jump_abs(byte.arg);
+        DISPATCH();
+    TARGET(LOAD_NONE) frame->push(None); DISPATCH();
+    TARGET(LOAD_TRUE) frame->push(True); DISPATCH();
+    TARGET(LOAD_FALSE) frame->push(False); DISPATCH();
+    TARGET(LOAD_ELLIPSIS) frame->push(Ellipsis); DISPATCH();
+    TARGET(ASSERT) {
+        PyVar _msg = frame->pop_value(this);
+        Str msg = CAST(Str, asStr(_msg));
+        PyVar expr = frame->pop_value(this);
+        if(asBool(expr) != True) RAISE_IN_FRAME(Exception("AssertionError", msg));
+    } DISPATCH();
+    TARGET(EXCEPTION_MATCH) {
+        const auto& e = CAST(Exception&, frame->top());
+        StrName name = frame->co->names[byte.arg].first;
+        frame->push(VAR(e.match_type(name)));
+    } DISPATCH();
+    TARGET(RAISE) {
+        PyVar obj = frame->pop_value(this);
+        Str msg = obj == None ? "" : CAST(Str, asStr(obj));
+        StrName type = frame->co->names[byte.arg].first;
+        RAISE_IN_FRAME(Exception(type, msg));
+    } DISPATCH();
+    TARGET(RE_RAISE) {
+        if(frame->jump_to_exception_handler()) DISPATCH();
+        return _py_op_raise;
+    }
+    TARGET(BUILD_LIST)
+        frame->push(VAR(frame->pop_n_values_reversed(this, byte.arg).move_to_list()));
+        DISPATCH();
+    TARGET(BUILD_MAP) {
+        Args items = frame->pop_n_values_reversed(this, byte.arg*2);
+        Dict dict;
+        for(int i=0; i<items.size(); i+=2) dict.set(this, items[i], items[i+1]);
+        frame->push(VAR(std::move(dict)));
+    } DISPATCH();
+    TARGET(BUILD_SET) {
+        Args items = frame->pop_n_values_reversed(this, byte.arg);
+        Set set;
+        for(int i=0; i<items.size(); i++) set.add(this, items[i]);
+        frame->push(VAR(std::move(set)));
+    } DISPATCH();
+    TARGET(LIST_APPEND) {
+        PyVar obj = frame->pop_value(this);
+        List& list = CAST(List&, frame->top_1());
+        list.push_back(std::move(obj));
+    } DISPATCH();
+    TARGET(MAP_ADD) {
+        PyVar value = frame->pop_value(this);
+        PyVar key = frame->pop_value(this);
+        CAST(Dict&, frame->top_1()).set(this, key, value);
+    } DISPATCH();
+    TARGET(SET_ADD) {
+        PyVar obj = frame->pop_value(this);
+        CAST(Set&, frame->top_1()).add(this, obj);
+    } DISPATCH();
+    TARGET(DUP_TOP_VALUE) frame->push(frame->top_value(this)); DISPATCH();
+    TARGET(DUP_TOP_TWO) {
+        PyVar a = frame->top_1();
+        PyVar b = frame->top();
+        frame->push(std::move(a));
+        frame->push(std::move(b));
+    } DISPATCH();
+    TARGET(UNARY_STAR) {
+        if(byte.arg > 0){   // rvalue
+            frame->top() = VAR(StarWrapper(frame->top_value(this), true));
+        }else{
+            PyRef_AS_C(frame->top()); // check ref
+            frame->top() = VAR(StarWrapper(frame->top(), false));
+        }
+    } DISPATCH();
+    TARGET(CALL_KWARGS_UNPACK) TARGET(CALL_KWARGS) {
+        int ARGC = byte.arg & 0xFFFF;
+        int KWARGC = (byte.arg >> 16) & 0xFFFF;
+        Args kwargs = frame->pop_n_values_reversed(this, KWARGC*2);
+        Args args = frame->pop_n_values_reversed(this, ARGC);
+        if(byte.op == OP_CALL_KWARGS_UNPACK) unpack_args(args);
+        PyVar callable = frame->pop_value(this);
+        PyVar ret = call(callable, std::move(args), kwargs, true);
+        if(ret == _py_op_call) return ret;
+        frame->push(std::move(ret));
+    } DISPATCH();
+    TARGET(CALL_UNPACK) {
+        Args args = frame->pop_n_values_reversed(this, byte.arg);
+        unpack_args(args);
+        PyVar callable = frame->pop_value(this);
+        PyVar ret = call(callable, std::move(args), no_arg(), true);
+        if(ret == _py_op_call) return ret;
+        frame->push(std::move(ret));
+    } DISPATCH();
+    TARGET(CALL) {
+        // the stack holds [callable, args...], the arguments are passed in place
+        int argc = byte.arg;
+        PyVar* argv = frame->_sp - argc;
+        for(int i=-1; i<argc; i++) frame->try_deref(this, argv[i]);
+        if(QUICKEN_WARM()) QUICKEN(argv[-1], argv[-1]);
+        PyVar callable = std::move(argv[-1]);
+        if(is_type(callable, tp_bound_method)){
+            // self goes into the callable's slot
+            const BoundMethod& bm = OBJ_GET(BoundMethod, callable);
+            PyVar method = bm.method;
+            argv[-1] = bm.obj;
+            callable = std::move(method);
+            argv--; argc++;
+        }
+        PyVar ret = vectorcall(callable, argv, argc, true);
+        frame->_shrink_to(frame->_sp - byte.arg - 1);
+        if(ret == _py_op_call) return ret;
+        frame->push(std::move(ret));
+    } DISPATCH();
+    TARGET(CALL_METHOD) {
+        // the stack holds [callable, self or null, args...], the arguments are passed in place
+        int argc = byte.arg;
+        PyVar* argv = frame->_sp - argc;
+        for(int i=0; i<argc; i++) frame->try_deref(this, argv[i]);
+        if(argv[-1] != nullptr){ argv--; argc++; }
+        PyVar callable = std::move(frame->_sp[-byte.arg - 2]);
+        PyVar ret = vectorcall(callable, argv, argc, true);
+        frame->_shrink_to(frame->_sp - byte.arg - 2);
+        if(ret == _py_op_call) return ret;
+        frame->push(std::move(ret));
+    } DISPATCH();
+    TARGET(JUMP_ABSOLUTE) frame->jump_abs(byte.arg); DISPATCH();
+    TARGET(SAFE_JUMP_ABSOLUTE) frame->jump_abs_safe(byte.arg); DISPATCH();
+    TARGET(GOTO) {
+        StrName label = frame->co->names[byte.arg].first;
+        auto it = frame->co->labels.find(label);
+        if(it == frame->co->labels.end()) _error("KeyError", "label " + label.str().escape(true) + " not found");
+        frame->jump_abs_safe(it->second);
+    } DISPATCH();
+    TARGET(GET_ITER) {
+        frame->top() = asIter(frame->top_value_ref(this));
+    } DISPATCH();
+    TARGET(FOR_ITER) {
+        if(QUICKEN_WARM()) QUICKEN(frame->top(), frame->top());
+        BaseIter* it = PyIter_AS_C(frame->top());
+        PyVar obj = it->next();
+        if(obj != nullptr){
+            frame->push(std::move(obj));
+        }else{
             int blockEnd = frame->co->blocks[byte.block].end;
             frame->jump_abs_safe(blockEnd);
-        } continue;
-        case OP_JUMP_IF_FALSE_OR_POP: {
-            const PyVar expr = frame->top_value(this);
-            if(asBool(expr)==False) frame->jump_abs(byte.arg);
-            else frame->pop_value(this);
-        } continue;
-        case OP_JUMP_IF_TRUE_OR_POP: {
-            const PyVar expr = frame->top_value(this);
-            if(asBool(expr)==True) frame->jump_abs(byte.arg);
-            else frame->pop_value(this);
-        } continue;
-        case OP_BUILD_SLICE: {
-            PyVar stop = frame->pop_value(this);
-            PyVar start = frame->pop_value(this);
-            Slice s;
-            if(start != None) { s.start = CAST(int, start);}
-            if(stop != None) { s.stop = CAST(int, stop);}
-            frame->push(VAR(s));
-        } continue;
-        case OP_IMPORT_NAME: {
-            StrName name = frame->co->names[byte.arg].first;
-            PyVar* ext_mod = _modules.try_get(name);
-            if(ext_mod == nullptr){
-                Str source;
-                auto it2 = _lazy_modules.find(name);
-                if(it2 == _lazy_modules.end()){
-                    bool ok = false;
-                    source = _read_file_cwd(name.str() + ".py", &ok);
-                    if(!ok) _error("ImportError", "module " + name.str().escape(true) + " not found");
-                }else{
-                    source = it2->second;
-                    _lazy_modules.erase(it2);
-                }
-                CodeObject_ code = compile(source, name.str(), EXEC_MODE);
-                PyVar new_mod = new_module(name);
-                _exec(code, new_mod);
-                frame->push(new_mod);
-                new_mod->attr()._try_perfect_rehash();
+        }
+    } DISPATCH();
+    TARGET(LOOP_CONTINUE) {
+        int blockStart = frame->co->blocks[byte.block].start;
+        frame->jump_abs(blockStart);
+        _gc.collect_if_pending();
+    } DISPATCH();
+    TARGET(LOOP_BREAK) {
+        int blockEnd = frame->co->blocks[byte.block].end;
+        frame->jump_abs_safe(blockEnd);
+    } DISPATCH();
+    TARGET(JUMP_IF_FALSE_OR_POP) {
+        const PyVar& expr = frame->top_value_ref(this);
+        if(asBool(expr)==False) frame->jump_abs(byte.arg);
+        else frame->pop_value(this);
+    } DISPATCH();
+    TARGET(JUMP_IF_TRUE_OR_POP) {
+        const PyVar& expr = frame->top_value_ref(this);
+        if(asBool(expr)==True) frame->jump_abs(byte.arg);
+        else frame->pop_value(this);
+    } DISPATCH();
+    TARGET(BUILD_SLICE) {
+        PyVar stop = frame->pop_value(this);
+        PyVar start = frame->pop_value(this);
+        Slice s;
+        if(start != None) { s.start = CAST(int, start);}
+        if(stop != None) { s.stop = CAST(int, stop);}
+        frame->push(VAR(s));
+    } DISPATCH();
+    TARGET(IMPORT_NAME) {
+        StrName name = frame->co->names[byte.arg].first;
+        PyVar* ext_mod = _modules.try_get(name);
+        if(ext_mod == nullptr){
+            Str source;
+            auto it2 = _lazy_modules.find(name);
+            if(it2 == _lazy_modules.end()){
+                bool ok = false;
+                source = _read_file_cwd(name.str() + ".py", &ok);
+                if(!ok) _error("ImportError", "module " + name.str().escape(true) + " not found");
             }else{
-                frame->push(*ext_mod);
+                source = it2->second;
+                _lazy_modules.erase(it2);
             }
-        } continue;
-        case OP_STORE_ALL_NAMES: {
-            PyVar obj = frame->pop_value(this);
-            for(auto& [name, value]: obj->attr().items()){
-                Str s = name.str();
-                if(s.empty() || s[0] == '_') continue;
-                frame->f_globals().set(name, value);
-            }
-        }; continue;
-        case OP_YIELD_VALUE: return _py_op_yield;
-        // TODO: using "goto" inside with block may cause __exit__ not called
-        case OP_WITH_ENTER: call(frame->pop_value(this), __enter__); continue;
-        case OP_WITH_EXIT: call(frame->pop_value(this), __exit__); continue;
-        case OP_TRY_BLOCK_ENTER: frame->on_try_block_enter(); continue;
-        case OP_TRY_BLOCK_EXIT: frame->on_try_block_exit(); continue;
-        default: throw std::runtime_error(Str("opcode ") + OP_NAMES[byte.op] + " is not implemented");
+            CodeObject_ code = compile(source, name.str(), EXEC_MODE);
+            PyVar new_mod = new_module(name);
+            _exec(code, new_mod);
+            frame->push(new_mod);
+            new_mod->attr()._try_perfect_rehash();
+        }else{
+            frame->push(*ext_mod);
         }
-    }
+    } DISPATCH();
+    TARGET(STORE_ALL_NAMES) {
+        PyVar obj = frame->pop_value(this);
+        for(auto& [name, value]: obj->attr().items()){
+            Str s = name.str();
+            if(s.empty() || s[0] == '_') continue;
+            frame->f_globals().set(name, value);
+        }
+    } DISPATCH();
+    TARGET(YIELD_VALUE) return _py_op_yield;
+    // TODO: using "goto" inside with block may cause __exit__ not called
+    TARGET(WITH_ENTER) call(frame->pop_value(this), __enter__); DISPATCH();
+    TARGET(WITH_EXIT) call(frame->pop_value(this), __exit__); DISPATCH();
+    /**************************** specialized forms ****************************/
+#define BINARY_OP_SPECIALIZED(name, check, T, op)                       \
+    TARGET(name) {                                                      \
+        PyVar& lhs = frame->top_1();                                    \
+        const PyVar& rhs = frame->top();                                \
+        if(!(check)) DEOPT(BINARY_OP);                                  \
+        lhs = VAR(_CAST(T, lhs) op _CAST(T, rhs));                      \
+        frame->_pop();                                                  \
+    } DISPATCH();
 
-    if(frame->co->src->mode == EVAL_MODE || frame->co->src->mode == JSON_MODE){
-        if(frame->_data.size() != 1) throw std::runtime_error("_data.size() != 1 in EVAL/JSON_MODE");
-        return frame->pop_value(this);
+    BINARY_OP_SPECIALIZED(BINARY_ADD_INT, is_both_int(lhs, rhs), i64, +)
+    BINARY_OP_SPECIALIZED(BINARY_SUB_INT, is_both_int(lhs, rhs), i64, -)
+    BINARY_OP_SPECIALIZED(BINARY_ADD_FLOAT, is_float(lhs) && is_float(rhs), f64, +)
+    BINARY_OP_SPECIALIZED(BINARY_SUB_FLOAT, is_float(lhs) && is_float(rhs), f64, -)
+    BINARY_OP_SPECIALIZED(BINARY_MUL_FLOAT, is_float(lhs) && is_float(rhs), f64, *)
+#undef BINARY_OP_SPECIALIZED
+    TARGET(BINARY_MUL_INT) {
+        PyVar& lhs = frame->top_1();
+        const PyVar& rhs = frame->top();
+        i64 ret;
+        if(!is_both_int(lhs, rhs) || _mul_overflow(_CAST(i64, lhs), _CAST(i64, rhs), &ret)) DEOPT(BINARY_OP);
+        lhs = VAR(ret);
+        frame->_pop();
+    } DISPATCH();
+    TARGET(COMPARE_OP_INT) {
+        PyVar& lhs = frame->top_1();
+        const PyVar& rhs = frame->top();
+        if(!is_both_int(lhs, rhs)) DEOPT(COMPARE_OP);
+        lhs = VAR(_compare_op(byte.arg, _CAST(i64, lhs), _CAST(i64, rhs)));
+        frame->_pop();
+    } DISPATCH();
+    TARGET(COMPARE_OP_FLOAT) {
+        PyVar& lhs = frame->top_1();
+        const PyVar& rhs = frame->top();
+        if(!is_float(lhs) || !is_float(rhs)) DEOPT(COMPARE_OP);
+        lhs = VAR(_compare_op(byte.arg, _CAST(f64, lhs), _CAST(f64, rhs)));
+        frame->_pop();
+    } DISPATCH();
+    TARGET(BUILD_ATTR_INSTANCE) {
+        PyVar& obj = frame->top();
+        InlineCache& c = frame->co->inline_caches[frame->_ip];
+        if(obj.is_tagged() || _t(obj).get() != c.key || c.version != _t(obj)->attr()._version) DEOPT(BUILD_ATTR);
+        PyVar* val = _own_attr(obj, frame->co->names[byte.arg].first, c);
+        if(val == nullptr) DEOPT(BUILD_ATTR);
+        PyVar ret = *val;   // *val is owned by obj
+        obj = std::move(ret);
+    } DISPATCH();
+    TARGET(INDEX_LIST_INT) {
+        const PyVar& obj = frame->top_1();
+        const PyVar& index = frame->top();
+        if(!is_int(index) || !is_type(obj, tp_list)) DEOPT(BUILD_INDEX);
+        const List& list = OBJ_GET(List, obj);
+        i64 i = _CAST(i64, index);
+        if(i < 0) i += list.size();
+        if(i < 0 || i >= (i64)list.size()) DEOPT(BUILD_INDEX);     // the generic form raises IndexError
+        PyVar ret = list[i];
+        frame->_pop();
+        frame->top() = std::move(ret);
+    } DISPATCH();
+    TARGET(CALL_PY_EXACT_ARGS) {
+        const PyVar& callable = frame->_sp[-1 - byte.arg];
+        if(!is_type(callable, tp_function) || !_is_exact_args_call(OBJ_GET(Function, callable), byte.arg)) DEOPT(CALL);
+        PyVar fn_obj = callable;    // keeps fn alive until its frame is pushed
+        const Function& fn = OBJ_GET(Function, fn_obj);
+        const PyVar& _module = fn._module != nullptr ? fn._module : frame->_module;
+        std::unique_ptr<Frame> new_frame = _new_frame(fn.code, _module, nullptr, fn._closure);
+        // the arguments move down over the callable and become the first locals of the new
+        // frame, whose window starts at the new top of this one
+        PyVar* argv = frame->_sp - byte.arg;
+        argv[-1].reset();
+        for(int i=0; i<byte.arg; i++){
+            frame->try_deref(this, argv[i]);
+            argv[i-1] = std::move(argv[i]);
+        }
+        frame->_sp -= byte.arg + 1;
+        _push_frame(std::move(new_frame), byte.arg);
+        return _py_op_call;
     }
+    TARGET(FOR_ITER_RANGE) {
+        BaseIter* it = PyIter_AS_C(frame->top());
+        const PyVar& ref = it->ref();
+        if(ref == nullptr || !is_type(ref, tp_range)) DEOPT(FOR_ITER);
+        PyVarOrNull obj = _range_iter_next(it);
+        if(obj != nullptr){
+            frame->push(std::move(obj));
+        }else{
+            int blockEnd = frame->co->blocks[byte.block].end;
+            frame->jump_abs_safe(blockEnd);
+        }
+    } DISPATCH();
+    #undef QUICKEN_WARM
+    #undef QUICKEN
+    #undef DEOPT
+
+    TARGET(END_OF_CODE) {
+        if(frame->co->src->mode == EVAL_MODE || frame->co->src->mode == JSON_MODE){
+            if(frame->stack_size() != 1) throw std::runtime_error("stack_size() != 1 in EVAL/JSON_MODE");
+            return frame->pop_value(this);
+        }
 #if PK_EXTRA_CHECK
-    if(!frame->_data.empty()) throw std::runtime_error("_data.size() != 0 in EXEC_MODE");
+        if(!frame->stack_empty()) throw std::runtime_error("stack_size() != 0 in EXEC_MODE");
 #endif
-    return None;
+        return None;
+    }
+#if !PK_ENABLE_COMPUTED_GOTO
+        default: UNREACHABLE();
+        }
+#endif
+    }
+    #undef TARGET
+    #undef DISPATCH
+    #undef RAISE_IN_FRAME
+    UNREACHABLE();
 }
 
 } // namespace pkpy
\ No newline at end of file
@@ -56,6 +56,41 @@ struct CodeBlock {
     }
 };
 
+enum InlineCacheKind : uint8_t {
+    CACHE_ATTR_INSTANCE,    // no class attribute, only the instance dict
+    CACHE_ATTR_CLASS_VAR,
+    CACHE_ATTR_METHOD,      // function found on the class, bound on access
+    CACHE_ATTR_DESCRIPTOR,  // class attribute with __get__
+};
+
+// exceptions raised by codes in [start, end) jump to `target` with the stack cut to `depth`
+struct ExceptionTableEntry {
+    int start;
+    int end;
+    int target;
+    int depth = 0;      // set by compute_stack_sizes()
+};
+
+// a generic instruction is specialized after this many runs
+const int kQuickenWarmup = 8;
+// runs to wait after a failed specialization or a guard miss before trying again
+const int kQuickenBackoff = 64;
+
+// per-instruction cache filled in by the interpreter (LOAD_NAME, BUILD_ATTR and quickening)
+struct InlineCache {
+    const void* key = nullptr;  // globals dict or type object the entry is valid for
+    uint32_t version = 0;       // globals dict version or type version tag
+    uint32_t version_2 = 0;     // builtins dict version
+    PyVar* value = nullptr;     // slot of the global or of the class attribute
+    uint16_t hint = 0;          // slot of the attribute in the last instance dict or shape
+    InlineCacheKind kind = CACHE_ATTR_INSTANCE;
+    int16_t counter = 0;        // runs of a generic instruction until it is quickened
+    uint32_t shape = kNoShape;      // instance shape `hint` was found in, kNoShape if `hint` is a NameDict slot
+    uint32_t next_shape = kNoShape; // shape after a store to `hint`, equal to `shape` if it existed
+};
+
+const uint16_t kNoSlot = 0xffff;
+
 struct CodeObject {
     shared_ptr<SourceData> src;
     Str name;
@@ -66,17 +101,32 @@ struct CodeObject {
         this->name = name;
     }
 
-    std::vector<Bytecode> codes;
+    // mutable since quickening rewrites opcodes while frames run them
+    mutable std::vector<Bytecode> codes;
     List consts;
     std::vector<std::pair<StrName, NameScope>> names;
     std::map<StrName, int> global_names;
     std::vector<CodeBlock> blocks = { CodeBlock{NO_BLOCK, -1} };
     std::map<StrName, int> labels;
+    // innermost ranges come first, so the first match is the handler to use
+    std::vector<ExceptionTableEntry> exception_table;
 
     uint32_t perfect_locals_capacity = 2;
     uint32_t perfect_hash_seed = 0;
 
+    // function locals resolved to fixed slots, arguments first
+    std::vector<StrName> varnames;
+    std::map<StrName, int> varnames_inv;
+    // false if a nested function captures this scope, which needs the dict form
+    bool use_fast_locals = false;
+
+    // one entry per instruction, sized by optimize()
+    mutable std::vector<InlineCache> inline_caches;
+    // size of the value stack window a frame of this code needs, set by optimize()
+    int max_stack_size = 0;
+
     void optimize(VM* vm);
+    void compute_stack_sizes();
 
     bool add_label(StrName label){
         if(labels.count(label)) return false;
@@ -94,6 +144,14 @@ struct CodeObject {
         return names.size() - 1;
     }
 
+    int add_varname(StrName name){
+        auto it = varnames_inv.find(name);
+        if(it != varnames_inv.end()) return it->second;
+        varnames.push_back(name);
+        varnames_inv[name] = varnames.size() - 1;
+        return varnames.size() - 1;
+    }
+
     int add_const(PyVar v){
         consts.push_back(v);
         return consts.size() - 1;
@@ -120,5 +178,104 @@ struct CodeObject {
     /************************************************/
 };
 
+// net change of the stack depth made by `byte` when it falls through to the next instruction
+inline int _stack_effect(const Bytecode& byte){
+    switch(byte.op){
+        case OP_NO_OP: case OP_ROT_TWO: case OP_UNARY_NEGATIVE: case OP_UNARY_NOT:
+        case OP_UNARY_STAR: case OP_PRINT_EXPR: case OP_GET_ITER: case OP_BUILD_ATTR:
+        case OP_BUILD_ATTR_REF: case OP_BUILD_ATTR_INSTANCE: case OP_DELETE_NAME: case OP_DELETE_FAST:
+        case OP_SETUP_CLOSURE: case OP_SETUP_DECORATOR:
+        case OP_BEGIN_CLASS: case OP_JUMP_ABSOLUTE: case OP_SAFE_JUMP_ABSOLUTE: case OP_GOTO:
+        case OP_LOOP_BREAK: case OP_LOOP_CONTINUE:
+            return 0;
+        case OP_DUP_TOP_VALUE: case OP_LOAD_METHOD: case OP_IMPORT_NAME: case OP_LOAD_CONST:
+        case OP_LOAD_NONE: case OP_LOAD_TRUE: case OP_LOAD_FALSE: case OP_LOAD_EVAL_FN:
+        case OP_LOAD_FUNCTION: case OP_LOAD_ELLIPSIS: case OP_LOAD_NAME: case OP_LOAD_NAME_REF:
+        case OP_LOAD_FAST: case OP_EXCEPTION_MATCH: case OP_FAST_INDEX:
+        case OP_FOR_ITER: case OP_FOR_ITER_RANGE:
+            return 1;
+        case OP_DUP_TOP_TWO: return 2;
+        case OP_CALL: case OP_CALL_UNPACK: case OP_CALL_PY_EXACT_ARGS: return -byte.arg;
+        case OP_CALL_METHOD: return -byte.arg - 1;
+        case OP_CALL_KWARGS: case OP_CALL_KWARGS_UNPACK:
+            return -(byte.arg & 0xFFFF) - 2*((byte.arg >> 16) & 0xFFFF);
+        case OP_BUILD_LIST: case OP_BUILD_SET: case OP_BUILD_TUPLE:
+        case OP_BUILD_TUPLE_REF: case OP_BUILD_STRING:
+            return 1 - byte.arg;
+        case OP_BUILD_MAP: return 1 - 2*byte.arg;
+        case OP_UNPACK_SEQUENCE: return byte.arg - 1;
+        case OP_MAP_ADD: case OP_ASSERT: case OP_STORE_ATTR: case OP_STORE_REF: case OP_DELETE_SUBSCR:
+            return -2;
+        case OP_STORE_SUBSCR: return -3;
+        default:    // binary ops, stores and other instructions that consume their top operand
+            return -1;
+    }
+}
+
+// finds an upper bound of the stack depth over all paths by walking the jumps of the bytecode,
+// and the depth each exception handler restores
+void CodeObject::compute_stack_sizes(){
+    std::vector<int> depth(codes.size(), -1);
+    std::vector<int> pending;
+    int max_depth = 0;
+    auto visit = [&](int i, int d){
+        if(i < 0 || i >= codes.size() || d <= depth[i]) return;
+        depth[i] = d;
+        if(d > max_depth) max_depth = d;
+        pending.push_back(i);
+    };
+    // jump_abs_safe() pops the iterator of every for loop it leaves
+    auto visit_safe = [&](int from, int target, int d){
+        if(target < 0 || target >= codes.size()) return;
+        int i = codes[from].block;
+        while(i >= 0 && i != codes[target].block){
+            if(blocks[i].type == FOR_LOOP) d--;
+            i = blocks[i].parent;
+        }
+        if(i == codes[target].block) visit(target, d);
+    };
+    visit(0, 0);
+    while(!pending.empty()){
+        int i = pending.back(); pending.pop_back();
+        const Bytecode& byte = codes[i];
+        int d = depth[i];
+        int next = d + _stack_effect(byte);
+        if(next > max_depth) max_depth = next;
+        for(ExceptionTableEntry& e: exception_table){
+            if(e.start != i) continue;
+            // the handler starts with the depth on entering the range plus the exception
+            e.depth = d;
+            visit(e.target, d + 1);
+        }
+        switch(byte.op){
+            case OP_END_OF_CODE: case OP_RETURN_VALUE: case OP_RAISE: case OP_RE_RAISE:
+                break;
+            case OP_JUMP_ABSOLUTE: visit(byte.arg, d); break;
+            case OP_SAFE_JUMP_ABSOLUTE: visit_safe(i, byte.arg, d); break;
+            case OP_LOOP_CONTINUE: visit(blocks[byte.block].start, d); break;
+            case OP_LOOP_BREAK: visit_safe(i, blocks[byte.block].end, d); break;
+            case OP_GOTO:
+                for(auto& [_, target]: labels) visit_safe(i, target, d);
+                break;
+            case OP_FOR_ITER: case OP_FOR_ITER_RANGE:
+                visit_safe(i, blocks[byte.block].end, d);
+                visit(i+1, next);
+                break;
+            case OP_POP_JUMP_IF_FALSE:
+                visit(byte.arg, next); visit(i+1, next);
+                break;
+            case OP_JUMP_IF_TRUE_OR_POP: case OP_JUMP_IF_FALSE_OR_POP:
+                visit(byte.arg, d); visit(i+1, next);
+                break;
+            case OP_YIELD_VALUE:
+                // the yielded value is popped by the generator before it resumes
+                visit(i+1, next);
+                break;
+            default: visit(i+1, next); break;
+        }
+    }
+    // room for an exception object pushed by the VM while the stack is at its peak
+    max_stack_size = max_depth + 2;
+}
 
 } // namespace pkpy
\ No newline at end of file
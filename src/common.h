@@ -12,11 +12,13 @@
 #include <stack>
 #include <cmath>
 #include <cstdlib>
+#include <cstddef>
 #include <stdexcept>
 #include <vector>
 #include <string>
 #include <cstring>
 #include <chrono>
+#include <atomic>
 #include <string_view>
 #include <queue>
 #include <iomanip>
@@ -28,10 +30,35 @@
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include <limits>
 
 #define PK_VERSION				"0.9.5"
 #define PK_EXTRA_CHECK 			0
 
+#if defined(__GNUC__) || defined(__clang__)
+#define PK_ENABLE_COMPUTED_GOTO	1
+#else
+#define PK_ENABLE_COMPUTED_GOTO	0
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PK_ENABLE_SSE2			1
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define PK_ENABLE_SSE2			0
+#endif
+
+#ifdef _MSC_VER
+#define PK_NOINLINE				__declspec(noinline)
+#define PK_NO_UNIQUE_ADDRESS	[[msvc::no_unique_address]]
+#else
+#define PK_NOINLINE				__attribute__((noinline))
+#define PK_NO_UNIQUE_ADDRESS	[[no_unique_address]]
+#endif
+
 #if (defined(__ANDROID__) && __ANDROID_API__ <= 22) || defined(__EMSCRIPTEN__)
 #define PK_ENABLE_FILEIO 		0
 #else
@@ -55,7 +82,6 @@ namespace pkpy{
 namespace std = ::std;
 
 struct Dummy {  };
-struct DummyInstance {  };
 struct DummyModule { };
 #define DUMMY_VAL Dummy()
 
@@ -73,8 +99,8 @@ struct Type {
 
 //#define THREAD_LOCAL thread_local
 #define THREAD_LOCAL
-#define CPP_LAMBDA(x) ([](VM* vm, Args& args) { return x; })
-#define CPP_NOT_IMPLEMENTED() ([](VM* vm, Args& args) { vm->NotImplementedError(); return vm->None; })
+#define CPP_LAMBDA(x) ([](VM* vm, ArgsView args) { return x; })
+#define CPP_NOT_IMPLEMENTED() ([](VM* vm, ArgsView args) { vm->NotImplementedError(); return vm->None; })
 
 #ifdef POCKETPY_H
 #define UNREACHABLE() throw std::runtime_error( "L" + std::to_string(__LINE__) + " UNREACHABLE()!");
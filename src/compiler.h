@@ -150,7 +150,8 @@ private:
         if(type == F_STRING){
             parser->set_next_token(TK("@fstr"), VAR(s));
         }else{
-            parser->set_next_token(TK("@str"), VAR(s));
+            // JSON_MODE strings are data, interning them would keep every one alive
+            parser->set_next_token(TK("@str"), mode()==JSON_MODE ? VAR(s) : vm->_intern(s));
         }
     }
 
@@ -395,13 +396,64 @@ private:
             consume(TK(":"));
         }
         func.code = make_sp<CodeObject>(parser->src, func.name.str());
+        _add_f_varnames(func);
         this->codes.push(func.code);
         co()->_rvalue += 1; EXPR(); co()->_rvalue -= 1;
         emit(OP_RETURN_VALUE);
+        emit(OP_END_OF_CODE, -1, true);
         func.code->optimize(vm);
         this->codes.pop();
         emit(OP_LOAD_FUNCTION, co()->add_const(VAR(func)));
-        if(name_scope() == NAME_LOCAL) emit(OP_SETUP_CLOSURE);
+        if(name_scope() == NAME_LOCAL) _emit_setup_closure();
+    }
+
+    // the operand of `.`, `[]` and `()` is always dereferenced, so build it as a value
+    void _lvalue_to_rvalue() {
+        if(co()->codes.empty()) return;
+        Bytecode& byte = co()->codes.back();
+        switch(byte.op){
+            case OP_LOAD_NAME_REF: byte.op = OP_LOAD_NAME; break;
+            case OP_BUILD_ATTR_REF: byte.op = OP_BUILD_ATTR; break;
+            case OP_BUILD_INDEX: byte.arg = 1; break;
+            case OP_BUILD_TUPLE_REF: byte.op = OP_BUILD_TUPLE; break;
+            default: break;
+        }
+    }
+
+    bool _is_jump_target(int begin, int end) {
+        for(const Bytecode& byte: co()->codes){
+            switch(byte.op){
+                case OP_JUMP_ABSOLUTE: case OP_SAFE_JUMP_ABSOLUTE: case OP_POP_JUMP_IF_FALSE:
+                case OP_JUMP_IF_TRUE_OR_POP: case OP_JUMP_IF_FALSE_OR_POP:
+                    if(byte.arg >= begin && byte.arg < end) return true;
+                    break;
+                default: break;
+            }
+        }
+        return false;
+    }
+
+    // `a, b = ...` with plain names unpacks onto the stack instead of building a TupleRef
+    bool _try_unpack_names(int lhs) {
+        int n = co()->codes[lhs].arg;
+        if(lhs - n < 0 || _is_jump_target(lhs - n + 1, lhs + 1)) return false;
+        for(int i=lhs-n; i<lhs; i++){
+            if(co()->codes[i].op != OP_LOAD_NAME_REF) return false;
+        }
+        std::vector<int> names;
+        for(int i=lhs-n; i<lhs; i++){
+            names.push_back(co()->codes[i].arg);
+            co()->codes[i].op = OP_NO_OP;
+        }
+        co()->codes[lhs].op = OP_NO_OP;
+        EXPR_TUPLE();
+        _emit_store_names(names);
+        return true;
+    }
+
+    void _emit_store_names(const std::vector<int>& names) {
+        if(names.size() > 1) emit(OP_UNPACK_SEQUENCE, names.size());
+        for(int index: names) emit(OP_STORE_NAME, index);
     }
 
     void exprAssign() {
@@ -409,21 +461,47 @@ private:
         co()->_rvalue += 1;
         TokenIndex op = parser->prev.type;
         if(op == TK("=")) {     // a = (expr)
+            uint8_t lhs_op = lhs == -1 ? (uint8_t)OP_NO_OP : co()->codes[lhs].op;
+            if(lhs_op == OP_BUILD_TUPLE_REF && !co()->_is_compiling_class && _try_unpack_names(lhs)){
+                co()->_rvalue -= 1;
+                return;
+            }
             EXPR_TUPLE();
-            if(lhs!=-1 && co()->codes[lhs].op == OP_LOAD_NAME_REF){
+            int arg = lhs == -1 ? -1 : co()->codes[lhs].arg;
+            if(lhs_op == OP_LOAD_NAME_REF){
                 if(co()->_is_compiling_class){
-                    emit(OP_STORE_CLASS_ATTR, co()->codes[lhs].arg);
+                    emit(OP_STORE_CLASS_ATTR, arg);
                 }else{
-                    emit(OP_STORE_NAME, co()->codes[lhs].arg);
+                    emit(OP_STORE_NAME, arg);
                 }
-                co()->codes[lhs].op = OP_NO_OP;
-                co()->codes[lhs].arg = -1;
             }else{
                 if(co()->_is_compiling_class) SyntaxError();
-                emit(OP_STORE_REF);
+                if(lhs_op == OP_BUILD_ATTR_REF) emit(OP_STORE_ATTR, arg);
+                else if(lhs_op == OP_BUILD_INDEX && arg == 0) emit(OP_STORE_SUBSCR);
+                else { emit(OP_STORE_REF); lhs = -1; }
+            }
+            if(lhs != -1){
+                co()->codes[lhs].op = OP_NO_OP;
+                co()->codes[lhs].arg = -1;
             }
         }else{                  // a += (expr) -> a = a + (expr)
             if(co()->_is_compiling_class) SyntaxError();
+            if(lhs == -1) SyntaxError();
+            // load the current value while keeping the target's object (and index) on the stack
+            Bytecode& target = co()->codes[lhs];
+            uint8_t lhs_op = target.op;
+            int arg = target.arg;
+            if(lhs_op == OP_LOAD_NAME_REF){
+                target.op = OP_LOAD_NAME;
+            }else if(lhs_op == OP_BUILD_ATTR_REF){
+                target.op = OP_DUP_TOP_VALUE; target.arg = -1;
+                emit(OP_BUILD_ATTR, arg);
+            }else if(lhs_op == OP_BUILD_INDEX && arg == 0){
+                target.op = OP_DUP_TOP_TWO; target.arg = -1;
+                emit(OP_BUILD_INDEX, 1);
+            }else{
+                SyntaxError("illegal expression for augmented assignment");
+            }
             EXPR();
             switch (op) {
                 case TK("+="):      emit(OP_INPLACE_BINARY_OP, 0);  break;
@@ -439,6 +517,9 @@ private:
                 case TK("^="):      emit(OP_INPLACE_BITWISE_OP, 4);  break;
                 default: UNREACHABLE();
             }
+            if(lhs_op == OP_LOAD_NAME_REF) emit(OP_STORE_NAME, arg);
+            else if(lhs_op == OP_BUILD_ATTR_REF) emit(OP_STORE_ATTR, arg);
+            else emit(OP_STORE_SUBSCR);
         }
         co()->_rvalue -= 1;
     }
@@ -535,7 +616,8 @@ private:
         co()->codes[_patch].op = OP_JUMP_ABSOLUTE;
         co()->codes[_patch].arg = _body_end;
         emit(op0, 0);
-        EXPR_FOR_VARS();consume(TK("in"));EXPR_TUPLE();
+        std::vector<int> vars = EXPR_FOR_VARS();
+        consume(TK("in"));EXPR_TUPLE();
         match_newlines(mode()==REPL_MODE);
         
         int _skipPatch = emit(OP_JUMP_ABSOLUTE);
@@ -550,6 +632,7 @@ private:
         emit(OP_GET_ITER);
         co()->_enter_block(FOR_LOOP);
         emit(OP_FOR_ITER);
+        _emit_store_names(vars);
 
         if(_cond_end_return != -1) {      // there is an if condition
             emit(OP_JUMP_ABSOLUTE, _cond_start);
@@ -620,6 +703,14 @@ private:
     }
 
     void exprCall() {
+        _lvalue_to_rvalue();
+        // `obj.name(...)` pushes the function and obj instead of a bound method
+        int method_i = -1;
+        int curr_i = co()->codes.size();
+        if(curr_i > 0 && co()->codes.back().op == OP_BUILD_ATTR && !_is_jump_target(curr_i, curr_i+1)){
+            method_i = curr_i - 1;
+            co()->codes[method_i].op = OP_LOAD_METHOD;
+        }
         int ARGC = 0;
         int KWARGC = 0;
         bool need_unpack = false;
@@ -644,6 +735,12 @@ private:
         consume(TK(")"));
         if(ARGC > 32767) SyntaxError("too many positional arguments");
         if(KWARGC > 32767) SyntaxError("too many keyword arguments");
+        if(method_i >= 0 && (KWARGC > 0 || need_unpack)){
+            co()->codes[method_i].op = OP_BUILD_ATTR;
+        }else if(method_i >= 0){
+            emit(OP_CALL_METHOD, ARGC);
+            return;
+        }
         if(KWARGC > 0){
             emit(need_unpack ? OP_CALL_KWARGS_UNPACK : OP_CALL_KWARGS, (KWARGC << 16) | ARGC);
         }else{
@@ -651,16 +748,14 @@ private:
         }
     }
 
-    void exprName(){ _exprName(false); }
-
-    void _exprName(bool force_lvalue) {
+    void exprName(){
         Token tkname = parser->prev;
         int index = co()->add_name(tkname.str(), name_scope());
-        bool fast_load = !force_lvalue && co()->_rvalue>0;
-        emit(fast_load ? OP_LOAD_NAME : OP_LOAD_NAME_REF, index);
+        emit(co()->_rvalue ? OP_LOAD_NAME : OP_LOAD_NAME_REF, index);
     }
 
     void exprAttrib() {
+        _lvalue_to_rvalue();
         consume(TK("@id"));
         const Str& name = parser->prev.str();
         int index = co()->add_name(name, NAME_ATTR);
@@ -670,6 +765,9 @@ private:
     // [:], [:b]
     // [a], [a:], [a:b]
     void exprSubscript() {
+        _lvalue_to_rvalue();
+        int build_index_arg = (int)(co()->_rvalue>0);
+        co()->_rvalue += 1;
         if(match(TK(":"))){
             emit(OP_LOAD_NONE);
             if(match(TK("]"))){
@@ -694,7 +792,8 @@ private:
             }
         }
 
-        emit(OP_BUILD_INDEX, (int)(co()->_rvalue>0));
+        co()->_rvalue -= 1;
+        emit(OP_BUILD_INDEX, build_index_arg);
     }
 
     void exprValue() {
@@ -845,21 +944,24 @@ private:
         co()->_exit_block();
     }
 
-    void EXPR_FOR_VARS(){
-        int size = 0;
+    // loop variables are stored after OP_FOR_ITER pushes the next item
+    std::vector<int> EXPR_FOR_VARS(){
+        std::vector<int> names;
         do {
             consume(TK("@id"));
-            _exprName(true); size++;
+            names.push_back(co()->add_name(parser->prev.str(), name_scope()));
         } while (match(TK(",")));
-        if(size > 1) emit(OP_BUILD_TUPLE_REF, size);
+        return names;
     }
 
     void compile_for_loop() {
-        EXPR_FOR_VARS();consume(TK("in"));
+        std::vector<int> vars = EXPR_FOR_VARS();
+        consume(TK("in"));
         co()->_rvalue += 1; EXPR_TUPLE(); co()->_rvalue -= 1;
         emit(OP_GET_ITER);
         co()->_enter_block(FOR_LOOP);
         emit(OP_FOR_ITER);
+        _emit_store_names(vars);
         compile_block_body();
         emit(OP_LOOP_CONTINUE, -1, true);
         co()->_exit_block();
@@ -867,11 +969,13 @@ private:
 
     void compile_try_except() {
         co()->_enter_block(TRY_EXCEPT);
-        emit(OP_TRY_BLOCK_ENTER);
+        const int block = co()->_curr_block_i;
         compile_block_body();
-        emit(OP_TRY_BLOCK_EXIT);
         std::vector<int> patches = { emit(OP_JUMP_ABSOLUTE) };
         co()->_exit_block();
+        // the handlers follow the protected range, nested tries were added before this one
+        int end = co()->blocks[block].end;
+        co()->exception_table.push_back(ExceptionTableEntry{co()->blocks[block].start, end, end});
 
         do {
             consume(TK("except"));
@@ -956,10 +1060,10 @@ private:
             Token tkname = parser->prev;
             int index = co()->add_name(tkname.str(), name_scope());
             emit(OP_STORE_NAME, index);
-            emit(OP_LOAD_NAME_REF, index);
+            emit(OP_LOAD_NAME, index);
             emit(OP_WITH_ENTER);
             compile_block_body();
-            emit(OP_LOAD_NAME_REF, index);
+            emit(OP_LOAD_NAME, index);
             emit(OP_WITH_EXIT);
         } else if(match(TK("label"))){
             if(mode() != EXEC_MODE) SyntaxError("'label' is only available in EXEC_MODE");
@@ -985,7 +1089,15 @@ private:
             consume_end_stmt();
         } else if(match(TK("del"))){
             EXPR_TUPLE();
-            emit(OP_DELETE_REF);
+            Bytecode& target = co()->codes.back();
+            switch(target.op){
+                case OP_LOAD_NAME_REF: target.op = OP_DELETE_NAME; break;
+                case OP_BUILD_ATTR_REF: target.op = OP_DELETE_ATTR; break;
+                case OP_BUILD_INDEX:
+                    if(target.arg == 0){ target.op = OP_DELETE_SUBSCR; target.arg = -1; break; }
+                    emit(OP_DELETE_REF); break;
+                default: emit(OP_DELETE_REF); break;
+            }
             consume_end_stmt();
         } else if(match(TK("global"))){
             do {
@@ -1003,7 +1115,7 @@ private:
             // If last op is not an assignment, pop the result.
             uint8_t last_op = co()->codes.back().op;
             if( last_op!=OP_STORE_NAME && last_op!=OP_STORE_REF &&
-            last_op!=OP_INPLACE_BINARY_OP && last_op!=OP_INPLACE_BITWISE_OP &&
+            last_op!=OP_STORE_ATTR && last_op!=OP_STORE_SUBSCR &&
             last_op!=OP_STORE_ALL_NAMES && last_op!=OP_STORE_CLASS_ATTR){
                 for(int i=begin; i<end; i++){
                     if(co()->codes[i].op==OP_BUILD_TUPLE_REF) co()->codes[i].op = OP_BUILD_TUPLE;
@@ -1031,6 +1143,20 @@ private:
         emit(OP_END_CLASS);
     }
 
+    void _add_f_varnames(const Function& func){
+        // arguments take the first slots, in the order VM::call binds them
+        func.code->use_fast_locals = true;
+        for(StrName name: func.args) func.code->add_varname(name);
+        for(StrName name: func.kwargs_order) func.code->add_varname(name);
+        if(!func.starred_arg.empty()) func.code->add_varname(func.starred_arg);
+    }
+
+    void _emit_setup_closure(){
+        // the closure shares this scope's locals by reference
+        co()->use_fast_locals = false;
+        emit(OP_SETUP_CLOSURE);
+    }
+
     void _compile_f_args(Function& func, bool enable_type_hints){
         int state = 0;      // 0 for args, 1 for *args, 2 for k=v, 3 for **kwargs
         do {
@@ -1091,12 +1217,14 @@ private:
             if(!match(TK("None"))) consume(TK("@id"));
         }
         func.code = make_sp<CodeObject>(parser->src, func.name.str());
+        _add_f_varnames(func);
         this->codes.push(func.code);
         compile_block_body();
+        emit(OP_END_OF_CODE, -1, true);
         func.code->optimize(vm);
         this->codes.pop();
         emit(OP_LOAD_FUNCTION, co()->add_const(VAR(func)));
-        if(name_scope() == NAME_LOCAL) emit(OP_SETUP_CLOSURE);
+        if(name_scope() == NAME_LOCAL) _emit_setup_closure();
         if(!co()->_is_compiling_class){
             if(obj_name.empty()){
                 if(has_decorator) emit(OP_CALL, 1);
@@ -1104,10 +1232,8 @@ private:
             } else {
                 if(has_decorator) SyntaxError("decorator is not supported here");
                 emit(OP_LOAD_NAME, co()->add_name(obj_name, name_scope()));
-                int index = co()->add_name(func.name, NAME_ATTR);
-                emit(OP_BUILD_ATTR_REF, index);
                 emit(OP_ROT_TWO);
-                emit(OP_STORE_REF);
+                emit(OP_STORE_ATTR, co()->add_name(func.name, NAME_ATTR));
             }
         }else{
             if(has_decorator) emit(OP_CALL, 1);
@@ -1141,7 +1267,7 @@ private:
         }
         if(parser->peekchar() == '\n') lineno--;
         auto e = Exception("SyntaxError", msg);
-        e.st_push(parser->src->snapshot(lineno, cursor));
+        e.st_push(parser->src, lineno, cursor);
         throw e;
     }
     void SyntaxError(Str msg){ throw_err("SyntaxError", msg); }
@@ -1163,6 +1289,7 @@ public:
         if(mode()==EVAL_MODE) {
             EXPR_TUPLE();
             consume(TK("@eof"));
+            emit(OP_END_OF_CODE, -1, true);
             code->optimize(vm);
             return code;
         }else if(mode()==JSON_MODE){
@@ -1172,6 +1299,8 @@ public:
             else if(match(TK("["))) exprList();
             else SyntaxError("expect a JSON object or array");
             consume(TK("@eof"));
+            emit(OP_END_OF_CODE, -1, true);
+            code->compute_stack_sizes();
             return code;    // no need to optimize for JSON decoding
         }
 
@@ -1183,6 +1312,7 @@ public:
             }
             match_newlines();
         }
+        emit(OP_END_OF_CODE, -1, true);
         code->optimize(vm);
         return code;
     }
@@ -0,0 +1,283 @@
+#pragma once
+
+#include "vm.h"
+
+namespace pkpy{
+
+// every change to the keys of a Dict draws a fresh version, so (dict, version) never repeats
+static THREAD_LOCAL uint32_t kDictVersion = 0;
+
+// insertion-ordered hash map: entries are appended to a dense array, and an open-addressing
+// table of indices into that array is probed with the hash cached in each entry
+struct Dict {
+    struct Item {
+        PyVar first;        // nullptr once the entry is deleted
+        PyVar second;
+        i64 hash;
+    };
+
+    static constexpr int kMinCapacity = 8;
+    static constexpr int kEmpty = -1;
+
+    std::vector<Item> _items;
+    std::vector<int> _indices;      // kEmpty or an index of _items, the size is a power of 2
+    int _size = 0;                  // live entries in _items
+    uint32_t _version = ++kDictVersion;     // of the keys, iterators check it
+
+    inline int size() const { return _size; }
+
+    // returns the position of `key` in _items, or -1; a user __eq__ may change the table, then
+    // the lookup starts over on the new one, as in CPython's lookdict
+    int _find(VM* vm, const PyVar& key, i64 hash) const {
+    restart:
+        if(_indices.empty()) return -1;
+        size_t mask = _indices.size() - 1;
+        size_t perturb = (size_t)hash;
+        size_t i = perturb & mask;
+        while(true){
+            int j = _indices[i];
+            if(j == kEmpty) return -1;
+            const Item& item = _items[j];
+            if(item.first != nullptr && item.hash == hash){
+                if(item.first == key) return j;
+                PyVar first = item.first;
+                uint32_t version = _version;
+                bool equal = vm->py_equals(first, key);
+                if(version != _version) goto restart;
+                if(equal) return j;
+            }
+            perturb >>= 5;
+            i = (i*5 + 1 + perturb) & mask;
+        }
+    }
+
+    void _insert_index(i64 hash, int j){
+        size_t mask = _indices.size() - 1;
+        size_t perturb = (size_t)hash;
+        size_t i = perturb & mask;
+        while(_indices[i] != kEmpty){
+            perturb >>= 5;
+            i = (i*5 + 1 + perturb) & mask;
+        }
+        _indices[i] = j;
+    }
+
+    // drops deleted entries and rebuilds the index table for at least `n` entries
+    void _rehash(int n){
+        if(_size != _items.size()){
+            std::vector<Item> items;
+            items.reserve(n);
+            for(Item& item: _items) if(item.first != nullptr) items.push_back(std::move(item));
+            _items = std::move(items);
+        }
+        int capacity = kMinCapacity;
+        while(capacity * 2 < n * 3) capacity <<= 1;
+        _indices.assign(capacity, kEmpty);
+        for(int j=0; j<_items.size(); j++) _insert_index(_items[j].hash, j);
+    }
+
+    PyVar* try_get(VM* vm, const PyVar& key) {
+        int j = _find(vm, key, vm->hash(key));
+        return j == -1 ? nullptr : &_items[j].second;
+    }
+
+    bool contains(VM* vm, const PyVar& key) const {
+        return _find(vm, key, vm->hash(key)) != -1;
+    }
+
+    void set(VM* vm, const PyVar& key, const PyVar& value){
+        _set(vm, key, value, vm->hash(key));
+    }
+
+    // `hash` must be vm->hash(key), e.g. taken from an item of another table
+    void _set(VM* vm, const PyVar& key, const PyVar& value, i64 hash){
+        int j = _find(vm, key, hash);
+        if(j != -1){
+            _items[j].second = value;
+            return;
+        }
+        // keep the index table at most 2/3 full, deleted entries count until the next rehash
+        if((_items.size() + 1) * 3 > _indices.size() * 2) _rehash(_size * 2 + 1);
+        _items.push_back(Item{key, value, hash});
+        _insert_index(hash, _items.size() - 1);
+        _size++;
+        _version = ++kDictVersion;
+    }
+
+    // deleted entries keep their slot in the index table, so later probes do not stop early
+    bool erase(VM* vm, const PyVar& key){
+        int j = _find(vm, key, vm->hash(key));
+        if(j == -1) return false;
+        _items[j].first.reset();
+        _items[j].second.reset();
+        _size--;
+        _version = ++kDictVersion;
+        return true;
+    }
+
+    void clear(){
+        _items.clear();
+        _indices.clear();
+        _size = 0;
+        _version = ++kDictVersion;
+    }
+
+    void update(VM* vm, const Dict& other){
+        for(const Item& item: other._items){
+            if(item.first != nullptr) set(vm, item.first, item.second);
+        }
+    }
+
+    void _gc_traverse(GCVisitor& v) const {
+        for(const Item& item: _items){
+            if(item.first == nullptr) continue;
+            v(item.first);
+            v(item.second);
+        }
+    }
+    void _gc_clear(){ clear(); }
+};
+
+DEF_NATIVE_2(Dict, tp_dict)
+
+enum DictViewKind { DICT_KEYS, DICT_VALUES, DICT_ITEMS };
+
+// the lazy result of dict.keys(), dict.values() and dict.items()
+struct DictView {
+    PyVar dict;
+    DictViewKind kind;
+
+    void _gc_traverse(GCVisitor& v) const { v(dict); }
+    void _gc_clear(){ dict.reset(); }
+};
+
+// `p` is the table owned by `_ref`, a dict or a set
+class DictIter : public BaseIter {
+    int index = 0;
+    int size;
+    uint32_t version;
+    DictViewKind kind;
+    const Dict* p;
+public:
+    DictIter(VM* vm, PyVar _ref, const Dict* p, DictViewKind kind) : BaseIter(vm, _ref), kind(kind), p(p) {
+        size = p->size();
+        version = p->_version;
+    }
+
+    PyVar next(){
+        if(p->size() != size) vm->_error("RuntimeError", "dictionary changed size during iteration");
+        if(p->_version != version) vm->_error("RuntimeError", "dictionary keys changed during iteration");
+        while(index < p->_items.size()){
+            const Dict::Item& item = p->_items[index++];
+            if(item.first == nullptr) continue;
+            switch(kind){
+                case DICT_KEYS: return item.first;
+                case DICT_VALUES: return item.second;
+                case DICT_ITEMS: return VAR(two_args(item.first, item.second));
+            }
+        }
+        return nullptr;
+    }
+};
+
+// the elements of a set or frozenset, stored as the keys of a table without values
+struct Set {
+    Dict _table;
+
+    inline int size() const { return _table.size(); }
+    inline bool contains(VM* vm, const PyVar& elem) const { return _table.contains(vm, elem); }
+    inline void add(VM* vm, const PyVar& elem){ _table.set(vm, elem, nullptr); }
+    inline bool discard(VM* vm, const PyVar& elem){ return _table.erase(vm, elem); }
+    inline void clear(){ _table.clear(); }
+
+    void _gc_traverse(GCVisitor& v) const { _table._gc_traverse(v); }
+    void _gc_clear(){ clear(); }
+
+    // the algebra below reuses the hashes cached in the tables instead of calling vm->hash()
+    inline bool _contains_item(VM* vm, const Dict::Item& item) const {
+        return _table._find(vm, item.first, item.hash) != -1;
+    }
+
+    void update(VM* vm, const Set& other){
+        for(const Dict::Item& item: other._table._items){
+            if(item.first != nullptr) _table._set(vm, item.first, nullptr, item.hash);
+        }
+    }
+
+    void intersection_update(VM* vm, const Set& other){
+        Set ret;
+        for(const Dict::Item& item: _table._items){
+            if(item.first != nullptr && other._contains_item(vm, item)) ret._table._set(vm, item.first, nullptr, item.hash);
+        }
+        *this = std::move(ret);
+    }
+
+    void difference_update(VM* vm, const Set& other){
+        for(const Dict::Item& item: other._table._items){
+            if(item.first != nullptr && _contains_item(vm, item)) _table.erase(vm, item.first);
+        }
+    }
+
+    void symmetric_difference_update(VM* vm, const Set& other){
+        for(const Dict::Item& item: other._table._items){
+            if(item.first == nullptr) continue;
+            if(_contains_item(vm, item)) _table.erase(vm, item.first);
+            else _table._set(vm, item.first, nullptr, item.hash);
+        }
+    }
+
+    bool issubset(VM* vm, const Set& other) const {
+        if(size() > other.size()) return false;
+        for(const Dict::Item& item: _table._items){
+            if(item.first != nullptr && !other._contains_item(vm, item)) return false;
+        }
+        return true;
+    }
+
+    bool isdisjoint(VM* vm, const Set& other) const {
+        const Set& a = size() <= other.size() ? *this : other;
+        const Set& b = size() <= other.size() ? other : *this;
+        for(const Dict::Item& item: a._table._items){
+            if(item.first != nullptr && b._contains_item(vm, item)) return false;
+        }
+        return true;
+    }
+
+    // order independent, so equal sets hash the same
+    i64 hash() const {
+        i64 x = 1927868237;
+        for(const Dict::Item& item: _table._items){
+            if(item.first == nullptr) continue;
+            i64 h = item.hash;
+            x ^= (h ^ (h << 16) ^ 89869747) * 3644798167;
+        }
+        return x;
+    }
+};
+
+DEF_NATIVE_2(Set, tp_set)
+
+inline bool is_set_like(VM* vm, const PyVar& obj){
+    return is_type(obj, vm->tp_set) || is_type(obj, vm->tp_frozenset);
+}
+
+// the Set behind a set or frozenset, other iterables are collected into `tmp`
+inline const Set& _as_set(VM* vm, const PyVar& obj, Set& tmp){
+    if(is_set_like(vm, obj)) return OBJ_GET(Set, obj);
+    PyVar iter = vm->asIter(obj);
+    BaseIter* it = vm->PyIter_AS_C(iter);
+    for(PyVar elem = it->next(); elem != nullptr; elem = it->next()) tmp.add(vm, elem);
+    return tmp;
+}
+
+// the Set behind a set or frozenset operand of an operator, anything else is a TypeError
+inline const Set& _check_set(VM* vm, const PyVar& obj){
+    if(!is_set_like(vm, obj)) vm->TypeError("expected a set or frozenset, got " + OBJ_NAME(vm->_t(obj)).escape(true));
+    return OBJ_GET(Set, obj);
+}
+
+inline i64 _frozenset_hash(VM* vm, const PyVar& obj){
+    return OBJ_GET(Set, obj).hash();
+}
+
+} // namespace pkpy
@@ -69,25 +69,34 @@ struct SourceData {
     ~SourceData() { free((void*)source); }
 };
 
+// a traceback line, only formatted when the traceback is printed
+struct TracebackEntry {
+    shared_ptr<SourceData> src;
+    int lineno;
+    const char* cursor;
+};
+
 class Exception {
     StrName type;
     Str msg;
-    std::stack<Str> stacktrace;
+    std::vector<TracebackEntry> stacktrace;     // innermost first
 public:
     Exception(StrName type, Str msg): type(type), msg(msg) {}
     bool match_type(StrName type) const { return this->type == type;}
     bool is_re = true;
 
-    void st_push(Str snapshot){
-        if(stacktrace.size() >= 8) return;
-        stacktrace.push(snapshot);
+    int st_size() const { return stacktrace.size(); }
+
+    void st_push(const shared_ptr<SourceData>& src, int lineno, const char* cursor=nullptr){
+        stacktrace.push_back(TracebackEntry{src, lineno, cursor});
     }
 
     Str summary() const {
-        std::stack<Str> st(stacktrace);
         StrStream ss;
         if(is_re) ss << "Traceback (most recent call last):\n";
-        while(!st.empty()) { ss << st.top() << '\n'; st.pop(); }
+        for(auto it=stacktrace.rbegin(); it!=stacktrace.rend(); it++){
+            ss << it->src->snapshot(it->lineno, it->cursor) << '\n';
+        }
         if (!msg.empty()) ss << type.str() << ": " << msg;
         else ss << type.str();
         return ss.str();
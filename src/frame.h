@@ -6,8 +6,87 @@ namespace pkpy{
 
 static THREAD_LOCAL uint64_t kFrameGlobalId = 0;
 
+// slots of a segment of the value stack, larger windows get a segment of their own size
+const int kValueStackSize = 65536;
+
+// the value stack of a VM, each running frame uses a window of it. It is a chain of
+// segments, a window that does not fit in the rest of its caller's segment starts at the
+// beginning of the next one, so windows never move while native code points into them
+struct ValueStack {
+    struct Segment {
+        PyVar* begin;
+        PyVar* end;
+    };
+    std::vector<Segment> _segments;
+
+    ValueStack(){ _segments.push_back(_new_segment(kValueStackSize)); }
+
+    ValueStack(const ValueStack&) = delete;
+    ValueStack& operator=(const ValueStack&) = delete;
+    ~ValueStack(){ for(Segment& s: _segments) delete[] s.begin; }
+
+    static Segment _new_segment(int size){
+        PyVar* p = new PyVar[size];
+        return Segment{p, p + size};
+    }
+
+    // the base of a window of `n` slots at `base` in segment `seg`, moving on to the next
+    // segment if it does not fit; frames are LIFO, so no window lives in a later segment
+    PyVar* place(int& seg, PyVar* base, int n){
+        if(base + n <= _segments[seg].end) return base;
+        seg++;
+        if(seg == _segments.size()){
+            _segments.push_back(_new_segment(std::max(n, kValueStackSize)));
+        }else if(_segments[seg].end - _segments[seg].begin < n){
+            delete[] _segments[seg].begin;
+            _segments[seg] = _new_segment(std::max(n, kValueStackSize));
+        }
+        return _segments[seg].begin;
+    }
+};
+
+// recycles the memory of the frames of a VM so calls do not go through malloc; each block
+// starts with a pointer to its pool, so a frame is given back where it came from
+template<int __MaxSize=64>
+struct FramePool {
+    static const size_t kHeader = alignof(std::max_align_t);
+    std::vector<void*> _free;
+
+    void* alloc(size_t n){
+        void* p;
+        if(_free.empty()){
+            p = malloc(kHeader + n);
+        }else{
+            p = _free.back();
+            _free.pop_back();
+        }
+        *(FramePool**)p = this;
+        return (char*)p + kHeader;
+    }
+
+    static void dealloc(void* obj){
+        void* p = (char*)obj - kHeader;
+        FramePool* pool = *(FramePool**)p;
+        if(pool->_free.size() >= __MaxSize) free(p);
+        else pool->_free.push_back(p);
+    }
+
+    FramePool() = default;
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+    ~FramePool(){ for(void* p: _free) free(p); }
+};
+
 struct Frame {
-    std::vector<PyVar> _data;
+    // [_fast_locals, _sp) is the window of the value stack owned by this frame, the locals
+    // come first and [_sp_base, _sp) are the operands
+    PyVar* _fast_locals = nullptr;  // slots of co->varnames if co->use_fast_locals
+    PyVar* _sp_base = nullptr;
+    PyVar* _sp = nullptr;
+    int _segment = 0;               // of the value stack the window is in
+    // holds the window of a frame that is not on the callstack: the locals of a new
+    // generator, or everything of a suspended one
+    std::vector<PyVar> _stack_backup;
     int _ip = -1;
     int _next_ip = 0;
 
@@ -16,7 +95,6 @@ struct Frame {
     NameDict_ _locals;
     NameDict_ _closure;
     const uint64_t id;
-    std::vector<std::pair<int, std::vector<PyVar>>> s_try_block;
 
     inline NameDict& f_locals() noexcept { return _locals != nullptr ? *_locals : _module->attr(); }
     inline NameDict& f_globals() noexcept { return _module->attr(); }
@@ -26,51 +104,123 @@ struct Frame {
         return _closure->try_get(name);
     }
 
+    inline int f_fast_index(StrName name) const {
+        if(!co->use_fast_locals) return -1;
+        auto it = co->varnames_inv.find(name);
+        return it == co->varnames_inv.end() ? -1 : it->second;
+    }
+
+    // a fast frame only has a locals dict after locals_dict() was called
+    inline PyVar* f_locals_try_get(StrName name){
+        if(!co->use_fast_locals) return f_locals().try_get(name);
+        return _locals != nullptr ? _locals->try_get(name) : nullptr;
+    }
+
+    // the dict form of locals, built from the fast locals on demand (e.g. eval/exec)
+    const NameDict_& locals_dict(){
+        if(!co->use_fast_locals) return _locals;
+        if(_locals == nullptr){
+            _locals = make_sp<NameDict>(co->perfect_locals_capacity, kLocalsLoadFactor, co->perfect_hash_seed);
+        }
+        for(int i=0; i<co->varnames.size(); i++){
+            StrName name = co->varnames[i];
+            if(_fast_locals[i] != nullptr) _locals->set(name, _fast_locals[i]);
+            else if(_locals->contains(name)) _locals->erase(name);
+        }
+        return _locals;
+    }
+
+    // write changes made through locals_dict() back to the fast locals
+    void sync_fast_locals(){
+        if(!co->use_fast_locals || _locals == nullptr) return;
+        for(int i=0; i<co->varnames.size(); i++){
+            PyVar* val = _locals->try_get(co->varnames[i]);
+            _fast_locals[i] = val != nullptr ? *val : nullptr;
+        }
+    }
+
     Frame(const CodeObject_& co,
         const PyVar& _module,
         const NameDict_& _locals=nullptr,
         const NameDict_& _closure=nullptr)
             : co(co.get()), _module(_module), _locals(_locals), _closure(_closure), id(kFrameGlobalId++) { }
 
+    // a frame whose fast locals are given up front, they are bound when it is pushed
+    Frame(const CodeObject_& co,
+        const PyVar& _module,
+        Args&& _fast_locals,
+        const NameDict_& _closure)
+            : co(co.get()), _module(_module), _closure(_closure), id(kFrameGlobalId++) {
+        for(int i=0; i<_fast_locals.size(); i++) _stack_backup.push_back(std::move(_fast_locals[i]));
+    }
+
+    ~Frame(){ _shrink_to(_fast_locals); }
+
+    // frames are allocated from the pool of their VM with `new(&vm->_frame_pool) Frame(...)`
+    static void* operator new(size_t n, FramePool<>* pool){ return pool->alloc(n); }
+    static void operator delete(void* p, FramePool<>*){ FramePool<>::dealloc(p); }
+    static void operator delete(void* p){ FramePool<>::dealloc(p); }
+
+    inline int _num_fast_locals() const { return co->use_fast_locals ? co->varnames.size() : 0; }
+    inline int _window_size() const { return _num_fast_locals() + co->max_stack_size; }
+
+    // places the window at `base`, restoring the values saved by _unbind_stack(); the slots
+    // of the locals are taken as they are, a caller may have placed arguments there
+    inline void _bind_stack(PyVar* base){
+        _fast_locals = base;
+        _sp_base = base + _num_fast_locals();
+        if(_stack_backup.empty()){
+            _sp = _sp_base;
+            return;
+        }
+        _sp = base;
+        for(PyVar& v: _stack_backup) *_sp++ = std::move(v);
+        _stack_backup.clear();
+    }
+
+    // moves the values out of the window, so a suspended generator can be resumed elsewhere
+    inline void _unbind_stack(){
+        for(PyVar* p=_fast_locals; p<_sp; p++) _stack_backup.push_back(std::move(*p));
+        _fast_locals = _sp_base = _sp = nullptr;
+    }
+
+    inline void _shrink_to(PyVar* sp){
+        while(_sp > sp) (--_sp)->reset();
+    }
+
+    inline int stack_size() const { return _sp - _sp_base; }
+    inline bool stack_empty() const { return _sp == _sp_base; }
+
     inline const Bytecode& next_bytecode() {
         _ip = _next_ip++;
         return co->codes[_ip];
     }
 
-    Str snapshot(){
-        int line = co->codes[_ip].line;
-        return co->src->snapshot(line);
-    }
+    inline int curr_lineno() const { return co->codes[_ip].line; }
 
     // Str stack_info(){
     //     StrStream ss;
     //     ss << "[";
-    //     for(int i=0; i<_data.size(); i++){
-    //         ss << OBJ_TP_NAME(_data[i]);
-    //         if(i != _data.size()-1) ss << ", ";
+    //     for(PyVar* p=_sp_base; p<_sp; p++){
+    //         ss << OBJ_TP_NAME(*p);
+    //         if(p != _sp-1) ss << ", ";
     //     }
     //     ss << "]";
     //     return ss.str();
     // }
 
-    inline bool has_next_bytecode() const {
-        return _next_ip < co->codes.size();
-    }
-
     inline PyVar pop(){
 #if PK_EXTRA_CHECK
-        if(_data.empty()) throw std::runtime_error("_data.empty() is true");
+        if(stack_empty()) throw std::runtime_error("stack_empty() is true");
 #endif
-        PyVar v = std::move(_data.back());
-        _data.pop_back();
-        return v;
+        return std::move(*--_sp);
     }
 
     inline void _pop(){
 #if PK_EXTRA_CHECK
-        if(_data.empty()) throw std::runtime_error("_data.empty() is true");
+        if(stack_empty()) throw std::runtime_error("stack_empty() is true");
 #endif
-        _data.pop_back();
+        (--_sp)->reset();
     }
 
     inline void try_deref(VM*, PyVar&);
@@ -87,48 +237,53 @@ struct Frame {
         return value;
     }
 
+    // like top_value() but dereferences the slot in place and borrows it, saving the
+    // copy; valid until the slot is popped or overwritten
+    inline PyVar& top_value_ref(VM* vm){
+        PyVar& value = top();
+        try_deref(vm, value);
+        return value;
+    }
+
     inline PyVar& top(){
 #if PK_EXTRA_CHECK
-        if(_data.empty()) throw std::runtime_error("_data.empty() is true");
+        if(stack_empty()) throw std::runtime_error("stack_empty() is true");
 #endif
-        return _data.back();
+        return _sp[-1];
     }
 
     inline PyVar& top_1(){
 #if PK_EXTRA_CHECK
-        if(_data.size() < 2) throw std::runtime_error("_data.size() < 2");
+        if(stack_size() < 2) throw std::runtime_error("stack_size() < 2");
 #endif
-        return _data[_data.size()-2];
+        return _sp[-2];
     }
 
     template<typename T>
-    inline void push(T&& obj){ _data.push_back(std::forward<T>(obj)); }
+    inline void push(T&& obj){
+#if PK_EXTRA_CHECK
+        if(stack_size() >= co->max_stack_size) throw std::runtime_error("value stack overflow");
+#endif
+        *_sp++ = std::forward<T>(obj);
+    }
 
     inline void jump_abs(int i){ _next_ip = i; }
     inline void jump_rel(int i){ _next_ip += i; }
 
-    inline void on_try_block_enter(){
-        s_try_block.emplace_back(co->codes[_ip].block, _data);
-    }
-
-    inline void on_try_block_exit(){
-        s_try_block.pop_back();
-    }
-
     bool jump_to_exception_handler(){
-        if(s_try_block.empty()) return false;
-        PyVar obj = pop();
-        auto& p = s_try_block.back();
-        _data = std::move(p.second);
-        _data.push_back(obj);
-        _next_ip = co->blocks[p.first].end;
-        on_try_block_exit();
-        return true;
+        for(const ExceptionTableEntry& e: co->exception_table){
+            if(_ip < e.start || _ip >= e.end) continue;
+            PyVar obj = pop();
+            _shrink_to(_sp_base + e.depth);
+            push(std::move(obj));
+            _next_ip = e.target;
+            return true;
+        }
+        return false;
     }
 
     int _exit_block(int i){
         if(co->blocks[i].type == FOR_LOOP) _pop();
-        else if(co->blocks[i].type == TRY_EXCEPT) on_try_block_exit();
         return co->blocks[i].parent;
     }
 
@@ -136,13 +291,10 @@ struct Frame {
         const Bytecode& prev = co->codes[_ip];
         int i = prev.block;
         _next_ip = target;
-        if(_next_ip >= co->codes.size()){
-            while(i>=0) i = _exit_block(i);
-        }else{
-            const Bytecode& next = co->codes[target];
-            while(i>=0 && i!=next.block) i = _exit_block(i);
-            if(i!=next.block) throw std::runtime_error("invalid jump");
-        }
+        // block ends never go past OP_END_OF_CODE, so `target` is always a valid index
+        const Bytecode& next = co->codes[target];
+        while(i>=0 && i!=next.block) i = _exit_block(i);
+        if(i!=next.block) throw std::runtime_error("invalid jump");
     }
 
     Args pop_n_values_reversed(VM* vm, int n){
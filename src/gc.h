@@ -0,0 +1,162 @@
+#pragma once
+
+#include "obj.h"
+
+namespace pkpy{
+
+// a generational collector for the reference cycles that refcounting cannot free, after
+// CPython's gcmodule: containers are tracked when they are created, and a collection finds
+// the tracked objects whose references all come from other tracked objects of the collected
+// generations. References it is not told about (native closures, frames, iterators) only
+// make objects look reachable, so a missing _gc_traverse can leak but never free too early.
+struct CycleCollector {
+    static const int kNumGenerations = 3;
+    static const int kReachable = -2;
+
+    struct Stats {
+        i64 collections = 0;
+        i64 collected = 0;
+    };
+
+    GCLink gens[kNumGenerations];       // list heads
+    // gen 0 counts allocations, the older ones count collections of the generation before
+    int counts[kNumGenerations] = {0, 0, 0};
+    int thresholds[kNumGenerations] = {700, 10, 10};
+    Stats stats[kNumGenerations];
+    // a full collection also waits for the objects moved to the oldest generation since the
+    // last one to reach 25% of the survivors of that one, so a growing heap is not rescanned
+    // over and over, as in CPython
+    i64 long_lived_total = 0;
+    i64 long_lived_pending = 0;
+    bool enabled = true;
+    bool _pending = false;              // a threshold was passed, collect at the next safe point
+    bool _collecting = false;
+
+    CycleCollector(){
+        for(GCLink& head: gens) head._gc_prev = head._gc_next = &head;
+    }
+
+    ~CycleCollector(){ detach_all(); }
+
+    // untracks every object, so that objects outliving the VM do not touch the list heads
+    void detach_all(){
+        for(GCLink& head: gens){
+            while(head._gc_next != &head) head._gc_next->_gc_unlink();
+        }
+    }
+
+    inline void track(GCHead* obj){
+        GCLink& head = gens[0];
+        obj->_gc_prev = head._gc_prev;
+        obj->_gc_next = &head;
+        head._gc_prev->_gc_next = obj;
+        head._gc_prev = obj;
+        if(++counts[0] > thresholds[0] && thresholds[0] > 0 && enabled) _pending = true;
+    }
+
+    // called by the interpreter where no native code holds unowned pointers into objects
+    inline void collect_if_pending(){
+        if(!_pending) return;
+        _pending = false;
+        int gen = 0;
+        for(int i=kNumGenerations-1; i>0; i--){
+            if(counts[i] <= thresholds[i] || thresholds[i] <= 0) continue;
+            if(i == kNumGenerations-1 && long_lived_pending < long_lived_total / 4) continue;
+            gen = i;
+            break;
+        }
+        collect(gen);
+    }
+
+    static inline void _traverse(GCHead* h, GCVisitor& v){
+        PyObject* obj = h->_obj();
+        _py_kinds[obj->_kind].gc_traverse(obj, v);
+    }
+
+    static void _splice(GCLink& from, GCLink& to){
+        if(from._gc_next == &from) return;
+        from._gc_next->_gc_prev = to._gc_prev;
+        to._gc_prev->_gc_next = from._gc_next;
+        from._gc_prev->_gc_next = &to;
+        to._gc_prev = from._gc_prev;
+        from._gc_prev = from._gc_next = &from;
+    }
+
+    // frees the unreachable cycles of generations 0..gen, returns how many objects they had
+    int collect(int gen){
+        if(_collecting) return 0;
+        _collecting = true;
+        for(int i=0; i<gen; i++) _splice(gens[i], gens[gen]);
+        GCLink& head = gens[gen];
+
+        std::vector<GCHead*> objs;
+        for(GCLink* p = head._gc_next; p != &head; p = p->_gc_next){
+            GCHead* obj = static_cast<GCHead*>(p);
+            int refs = ((int*)obj->_obj())[-1];     // the shared_ptr counter
+            // an immortal object is referenced by its VM
+            obj->_gc_refs = refs == kImmortalRefs ? std::numeric_limits<int>::max() : refs;
+            objs.push_back(obj);
+        }
+
+        // what is left of the counts are references from outside the collected objects
+        struct : GCVisitor {
+            void visit(PyObject* obj) override {
+                GCHead* h = obj->_gc_head();
+                if(h != nullptr && h->_gc_refs > 0) h->_gc_refs--;
+            }
+        } subtract_internal;
+        for(GCHead* obj: objs) _traverse(obj, subtract_internal);
+
+        struct Mark : GCVisitor {
+            std::vector<GCHead*> stack;
+            void visit(PyObject* obj) override {
+                GCHead* h = obj->_gc_head();
+                if(h == nullptr || h->_gc_refs < 0) return;     // untracked, older or already marked
+                h->_gc_refs = kReachable;
+                stack.push_back(h);
+            }
+        } mark;
+        for(GCHead* obj: objs){
+            if(obj->_gc_refs <= 0) continue;
+            obj->_gc_refs = kReachable;
+            mark.stack.push_back(obj);
+            while(!mark.stack.empty()){
+                GCHead* p = mark.stack.back();
+                mark.stack.pop_back();
+                _traverse(p, mark);
+            }
+        }
+
+        // hold the garbage while its references are cleared, so nothing is freed mid-loop
+        std::vector<PyVar> garbage;
+        for(GCHead* obj: objs){
+            if(obj->_gc_refs == 0){
+                int* counter = (int*)obj->_obj() - 1;
+                ++(*counter);
+                garbage.push_back(PyVar(counter));
+            }
+            obj->_gc_refs = -1;
+        }
+
+        i64 survivors = objs.size() - garbage.size();
+        if(gen + 1 < kNumGenerations){
+            _splice(head, gens[gen + 1]);
+            counts[gen + 1]++;
+            if(gen + 1 == kNumGenerations-1) long_lived_pending += survivors;
+        }else{
+            long_lived_total = survivors;
+            long_lived_pending = 0;
+        }
+        for(int i=0; i<=gen; i++) counts[i] = 0;
+        stats[gen].collections++;
+        stats[gen].collected += garbage.size();
+
+        for(PyVar& obj: garbage) _py_kinds[obj->_kind].gc_clear(obj.get());
+        int n = garbage.size();
+        garbage.clear();
+        _collecting = false;
+        return n;
+    }
+};
+
+} // namespace pkpy
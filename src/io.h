@@ -3,6 +3,55 @@
 #include "ceval.h"
 #include "cffi.h"
 
+namespace pkpy{
+
+// an in-memory text buffer that grows geometrically, for building a string piece by piece
+struct StringIO {
+    PY_CLASS(StringIO, io, StringIO)
+
+    std::string buffer;
+    bool closed = false;
+
+    StringIO(const Str& initial_value): buffer(initial_value) {}
+
+    void check_open(VM* vm){
+        if(closed) vm->ValueError("I/O operation on closed file");
+    }
+
+    static void _register(VM* vm, PyVar mod, PyVar type){
+        // a static method, bound with bind_func to take the keyword default
+        vm->bind_func<0>(type, "__new__", [](VM* vm, ArgsView args){
+            return VAR_T(StringIO, CAST(Str&, args[0]));
+        }, {{"initial_value", VAR("")}});
+
+        vm->bind_method<1>(type, "write", [](VM* vm, ArgsView args){
+            StringIO& io = CAST(StringIO&, args[0]);
+            io.check_open(vm);
+            const Str& s = CAST(Str&, args[1]);
+            io.buffer.append(s);
+            return VAR(s.u8_length());
+        });
+
+        vm->bind_method<0>(type, "getvalue", [](VM* vm, ArgsView args){
+            StringIO& io = CAST(StringIO&, args[0]);
+            io.check_open(vm);
+            return VAR(Str(io.buffer));
+        });
+
+        auto close = [](VM* vm, ArgsView args){
+            StringIO& io = CAST(StringIO&, args[0]);
+            io.closed = true;
+            std::string().swap(io.buffer);
+            return vm->None;
+        };
+        vm->bind_method<0>(type, "close", close);
+        vm->bind_method<0>(type, "__exit__", close);
+        vm->bind_method<0>(type, "__enter__", CPP_LAMBDA(vm->None));
+    }
+};
+
+} // namespace pkpy
+
 #if PK_ENABLE_FILEIO
 
 #include <fstream>
@@ -43,32 +92,32 @@ struct FileIO {
     }
 
     static void _register(VM* vm, PyVar mod, PyVar type){
-        vm->bind_static_method<2>(type, "__new__", [](VM* vm, Args& args){
+        vm->bind_static_method<2>(type, "__new__", [](VM* vm, ArgsView args){
             return VAR_T(FileIO, 
                 vm, CAST(Str, args[0]), CAST(Str, args[1])
             );
         });
 
-        vm->bind_method<0>(type, "read", [](VM* vm, Args& args){
+        vm->bind_method<0>(type, "read", [](VM* vm, ArgsView args){
             FileIO& io = CAST(FileIO&, args[0]);
             std::string buffer;
             io._fs >> buffer;
             return VAR(buffer);
         });
 
-        vm->bind_method<1>(type, "write", [](VM* vm, Args& args){
+        vm->bind_method<1>(type, "write", [](VM* vm, ArgsView args){
             FileIO& io = CAST(FileIO&, args[0]);
             io._fs << CAST(Str&, args[1]);
             return vm->None;
         });
 
-        vm->bind_method<0>(type, "close", [](VM* vm, Args& args){
+        vm->bind_method<0>(type, "close", [](VM* vm, ArgsView args){
             FileIO& io = CAST(FileIO&, args[0]);
             io._fs.close();
             return vm->None;
         });
 
-        vm->bind_method<0>(type, "__exit__", [](VM* vm, Args& args){
+        vm->bind_method<0>(type, "__exit__", [](VM* vm, ArgsView args){
             FileIO& io = CAST(FileIO&, args[0]);
             io._fs.close();
             return vm->None;
@@ -80,26 +129,27 @@ struct FileIO {
 
 void add_module_io(VM* vm){
     PyVar mod = vm->new_module("io");
+    StringIO::register_class(vm, mod);
     PyVar type = FileIO::register_class(vm, mod);
-    vm->bind_builtin_func<2>("open", [type](VM* vm, const Args& args){
-        return vm->call(type, args);
+    vm->bind_builtin_func<2>("open", [type](VM* vm, ArgsView args){
+        return vm->call(type, args.to_args());
     });
 }
 
 void add_module_os(VM* vm){
     PyVar mod = vm->new_module("os");
     // Working directory is shared by all VMs!!
-    vm->bind_func<0>(mod, "getcwd", [](VM* vm, const Args& args){
+    vm->bind_func<0>(mod, "getcwd", [](VM* vm, ArgsView args){
         return VAR(std::filesystem::current_path().string());
     });
 
-    vm->bind_func<1>(mod, "chdir", [](VM* vm, const Args& args){
+    vm->bind_func<1>(mod, "chdir", [](VM* vm, ArgsView args){
         std::filesystem::path path(CAST(Str&, args[0]).c_str());
         std::filesystem::current_path(path);
         return vm->None;
     });
 
-    vm->bind_func<1>(mod, "listdir", [](VM* vm, const Args& args){
+    vm->bind_func<1>(mod, "listdir", [](VM* vm, ArgsView args){
         std::filesystem::path path(CAST(Str&, args[0]).c_str());
         std::filesystem::directory_iterator di;
         try{
@@ -115,28 +165,28 @@ void add_module_os(VM* vm){
         return VAR(ret);
     });
 
-    vm->bind_func<1>(mod, "remove", [](VM* vm, const Args& args){
+    vm->bind_func<1>(mod, "remove", [](VM* vm, ArgsView args){
         std::filesystem::path path(CAST(Str&, args[0]).c_str());
         bool ok = std::filesystem::remove(path);
         if(!ok) vm->IOError("operation failed");
         return vm->None;
     });
 
-    vm->bind_func<1>(mod, "mkdir", [](VM* vm, const Args& args){
+    vm->bind_func<1>(mod, "mkdir", [](VM* vm, ArgsView args){
         std::filesystem::path path(CAST(Str&, args[0]).c_str());
         bool ok = std::filesystem::create_directory(path);
         if(!ok) vm->IOError("operation failed");
         return vm->None;
     });
 
-    vm->bind_func<1>(mod, "rmdir", [](VM* vm, const Args& args){
+    vm->bind_func<1>(mod, "rmdir", [](VM* vm, ArgsView args){
         std::filesystem::path path(CAST(Str&, args[0]).c_str());
         bool ok = std::filesystem::remove(path);
         if(!ok) vm->IOError("operation failed");
         return vm->None;
     });
 
-    vm->bind_func<-1>(mod, "path_join", [](VM* vm, const Args& args){
+    vm->bind_func<-1>(mod, "path_join", [](VM* vm, ArgsView args){
         std::filesystem::path path;
         for(int i=0; i<args.size(); i++){
             path /= CAST(Str&, args[i]).c_str();
@@ -144,7 +194,7 @@ void add_module_os(VM* vm){
         return VAR(path.string());
     });
 
-    vm->bind_func<1>(mod, "path_exists", [](VM* vm, const Args& args){
+    vm->bind_func<1>(mod, "path_exists", [](VM* vm, ArgsView args){
         std::filesystem::path path(CAST(Str&, args[0]).c_str());
         bool exists = std::filesystem::exists(path);
         return VAR(exists);
@@ -157,7 +207,11 @@ void add_module_os(VM* vm){
 #else
 
 namespace pkpy{
-void add_module_io(VM* vm){}
+void add_module_io(VM* vm){
+    PyVar mod = vm->new_module("io");
+    StringIO::register_class(vm, mod);
+}
+
 void add_module_os(VM* vm){}
 
 Str _read_file_cwd(const Str& name, bool* ok){
@@ -24,6 +24,11 @@ public:
     }
 };
 
+// FOR_ITER_RANGE steps the iterator without the virtual call
+inline PyVarOrNull _range_iter_next(BaseIter* it){
+    return static_cast<RangeIter*>(it)->RangeIter::next();
+}
+
 template <typename T>
 class ArrayIter : public BaseIter {
     size_t index = 0;
@@ -46,19 +51,90 @@ public:
 
     PyVar next() {
         if(index == str->u8_length()) return nullptr;
+        if(str->is_ascii()) return vm->_ascii_str_pool[(unsigned char)(*str)[index++]];
         return VAR(str->u8_getitem(index++));
     }
 };
 
+// the iterators below wrap the iterators of their arguments, created with vm->asIter()
+class EnumerateIter : public BaseIter {
+    i64 index;
+    BaseIter* it;
+public:
+    EnumerateIter(VM* vm, PyVar _ref, i64 start) : BaseIter(vm, _ref), index(start) {
+        it = vm->PyIter_AS_C(_ref);
+    }
+
+    PyVar next(){
+        PyVar obj = it->next();
+        if(obj == nullptr) return nullptr;
+        return VAR(two_args(VAR(index++), std::move(obj)));
+    }
+};
+
+class ZipIter : public BaseIter {
+    std::vector<PyVar> iters;
+public:
+    ZipIter(VM* vm, std::vector<PyVar>&& iters) : BaseIter(vm, nullptr), iters(std::move(iters)) {}
+
+    PyVar next(){
+        if(iters.empty()) return nullptr;
+        Args ret(iters.size());
+        for(int i=0; i<iters.size(); i++){
+            PyVar obj = vm->PyIter_AS_C(iters[i])->next();
+            if(obj == nullptr) return nullptr;
+            ret[i] = std::move(obj);
+        }
+        return VAR(std::move(ret));
+    }
+};
+
+class MapIter : public BaseIter {
+    PyVar f;
+    std::vector<PyVar> iters;
+public:
+    MapIter(VM* vm, PyVar f, std::vector<PyVar>&& iters) : BaseIter(vm, nullptr), f(f), iters(std::move(iters)) {}
+
+    PyVar next(){
+        Args args(iters.size());
+        for(int i=0; i<iters.size(); i++){
+            PyVar obj = vm->PyIter_AS_C(iters[i])->next();
+            if(obj == nullptr) return nullptr;
+            args[i] = std::move(obj);
+        }
+        return vm->call(f, std::move(args));
+    }
+};
+
+// a None predicate keeps the truthy elements
+class FilterIter : public BaseIter {
+    PyVar f;
+    BaseIter* it;
+public:
+    FilterIter(VM* vm, PyVar f, PyVar _ref) : BaseIter(vm, _ref), f(f) {
+        it = vm->PyIter_AS_C(_ref);
+    }
+
+    PyVar next(){
+        for(PyVar obj = it->next(); obj != nullptr; obj = it->next()){
+            PyVar ok = f == vm->None ? obj : vm->call(f, one_arg(obj));
+            if(vm->asBool(ok) == vm->True) return obj;
+        }
+        return nullptr;
+    }
+};
+
 PyVar Generator::next(){
     if(state == 2) return nullptr;
-    vm->callstack.push(std::move(frame));
+    vm->_push_frame(std::move(frame));
     PyVar ret = vm->_exec();
     if(ret == vm->_py_op_yield){
         frame = std::move(vm->callstack.top());
         vm->callstack.pop();
         state = 1;
-        return frame->pop_value(vm);
+        PyVar value = frame->pop_value(vm);
+        frame->_unbind_stack();
+        return value;
     }else{
         state = 2;
         return nullptr;
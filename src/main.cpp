@@ -41,7 +41,7 @@ std::string getline(bool* eof=nullptr){
 
 int main(int argc, char** argv){
     pkpy::VM* vm = pkpy_new_vm(true);
-    vm->bind_builtin_func<0>("input", [](pkpy::VM* vm, pkpy::Args& args){
+    vm->bind_builtin_func<0>("input", [](pkpy::VM* vm, pkpy::ArgsView args){
         return VAR(getline());
     });
     if(argc == 1){
@@ -5,20 +5,99 @@
 namespace pkpy{
 
 struct PyObject;
+inline void _py_destroy(PyObject* obj);     // objects have no vtable, see obj.h
+
+// size-class free lists for the blocks behind shared_ptr, carved from 64KB chunks;
+// a block is [int size class][int counter][object], so the object is 8-byte aligned
+// and the block goes back to its list without knowing the object's type. The pool is
+// thread-local because a VM is confined to one thread and the last decref has no VM
+// at hand. Chunks are never returned to the system.
+struct MemoryPool {
+    static const int kClassStep = 16;
+    static const int kNumClasses = 16;          // blocks of 16, 32, ... 256 bytes
+    static const int kLargeClass = kNumClasses; // bigger blocks use malloc directly
+    static const size_t kChunkSize = 64 * 1024;
+
+    struct FreeBlock { FreeBlock* next; };
+
+    FreeBlock* free_list[kNumClasses];
+    size_t allocs[kNumClasses+1];     // allocations by size class, for profiling
+    size_t frees[kNumClasses+1];
+
+    void _refill(int c){
+        size_t block_size = (c + 1) * kClassStep;
+        char* chunk = (char*)malloc(kChunkSize);
+        if(chunk == nullptr) throw std::bad_alloc();
+        for(size_t ofs = 0; ofs + block_size <= kChunkSize; ofs += block_size){
+            FreeBlock* b = (FreeBlock*)(chunk + ofs);
+            b->next = free_list[c];
+            free_list[c] = b;
+        }
+    }
+
+    // the bytes taken by the block of an object of `size` bytes
+    static size_t block_size(size_t size){
+        size_t n = 2 * sizeof(int) + size;
+        if(n > kNumClasses * kClassStep) return n;
+        return (n + kClassStep - 1) / kClassStep * kClassStep;
+    }
+
+    // returns the counter of a new block for an object of `size` bytes
+    inline int* alloc(size_t size){
+        size_t n = 2 * sizeof(int) + size;
+        int c = (n - 1) / kClassStep;
+        int* p;
+        if(c >= kNumClasses){
+            c = kLargeClass;
+            p = (int*)malloc(n);
+            if(p == nullptr) throw std::bad_alloc();
+        }else{
+            if(free_list[c] == nullptr) _refill(c);
+            p = (int*)free_list[c];
+            free_list[c] = free_list[c]->next;
+        }
+        allocs[c]++;
+        p[0] = c;
+        return p + 1;
+    }
 
+    inline void dealloc(int* counter){
+        int* p = counter - 1;
+        int c = p[0];
+        frees[c]++;
+        if(c == kLargeClass){
+            free(p);
+            return;
+        }
+        FreeBlock* b = (FreeBlock*)p;
+        b->next = free_list[c];
+        free_list[c] = b;
+    }
+};
+
+// zero-initialized and trivially destructible, so there is no guard on access
+inline thread_local MemoryPool pool;
+
+// kept out of line: shared_ptr's destructor is inlined everywhere and the smaller
+// call sites measured faster than inlining the free list operations
 template<typename T>
 struct SpAllocator {
     template<typename U>
-    inline static int* alloc(){
-        return (int*)malloc(sizeof(int) + sizeof(U));
+    PK_NOINLINE static int* alloc(){
+        return pool.alloc(sizeof(U));
     }
 
-    inline static void dealloc(int* counter){
-        ((T*)(counter + 1))->~T();
-        free(counter);
+    PK_NOINLINE static void dealloc(int* counter){
+        if constexpr(std::is_same_v<T, PyObject>) _py_destroy((PyObject*)(counter + 1));
+        else ((T*)(counter + 1))->~T();
+        pool.dealloc(counter);
     }
 };
 
+// the counter of an immortal object: it is never incremented or decremented, so shared
+// objects like None and the types cost no writes to copy, see VM::_make_immortal()
+static const int kImmortalRefs = std::numeric_limits<int>::min();
+
 template <typename T>
 struct shared_ptr {
     union {
@@ -27,8 +106,8 @@ struct shared_ptr {
     };
 
 #define _t() (T*)(counter + 1)
-#define _inc_counter() if(!is_tagged() && counter) ++(*counter)
-#define _dec_counter() if(!is_tagged() && counter && --(*counter) == 0) SpAllocator<T>::dealloc(counter)
+#define _inc_counter() if(!is_tagged() && counter && *counter >= 0) ++(*counter)
+#define _dec_counter() if(!is_tagged() && counter && *counter >= 0 && --(*counter) == 0) SpAllocator<T>::dealloc(counter)
 
 public:
     shared_ptr() : counter(nullptr) {}
@@ -70,9 +149,12 @@ public:
 
     int use_count() const { 
         if(is_tagged()) return 0;
+        if(is_immortal()) return std::numeric_limits<int>::max();
         return counter ? *counter : 0;
     }
 
+    inline bool is_immortal() const { return !is_tagged() && counter && *counter < 0; }
+
     void reset(){
         _dec_counter();
         counter = nullptr;
@@ -95,7 +177,7 @@ public:
     template <typename T, typename U, typename... Args>
     shared_ptr<T> make_sp(Args&&... args) {
         static_assert(std::is_base_of_v<T, U>, "U must be derived from T");
-        static_assert(std::has_virtual_destructor_v<T>, "T must have virtual destructor");
+        static_assert(std::is_same_v<T, PyObject> || std::has_virtual_destructor_v<T>, "T must have virtual destructor");
         static_assert(!std::is_same_v<T, PyObject> || (!std::is_same_v<U, i64> && !std::is_same_v<U, f64>));
         int* p = SpAllocator<T>::template alloc<U>(); *p = 1;
         new(p+1) U(std::forward<Args>(args)...);
@@ -135,6 +217,8 @@ struct SmallArrayPool {
         if(n > __Bucket || buckets[n].size() >= __BucketSize){
             delete[] p;
         }else{
+            // release the elements now, pooled arrays are handed out empty
+            for(int i=0; i<n; i++) p[i] = T();
             buckets[n].push_back(p);
         }
     }
@@ -31,6 +31,8 @@ struct DictArrayPool {
             for(int i=0; i<n; i++) _values[i].~PyVar();
             free(head);
         }else{
+            // pooled arrays must not keep their values alive
+            for(int i=0; i<n; i++) _values[i].reset();
             buckets[n].push_back(head);
         }
     }
@@ -49,6 +51,9 @@ uint16_t find_next_capacity(uint16_t n){
     return x;
 }
 
+// every change to the keys of a dict draws a fresh version, so (dict, version) never repeats
+static THREAD_LOCAL uint32_t kNameDictVersion = 0;
+
 #define _hash(key, mask, hash_seed) ( ( (key).index * (hash_seed) >> 8 ) & (mask) )
 
 uint16_t find_perfect_hash_seed(uint16_t capacity, const std::vector<StrName>& keys){
@@ -73,6 +78,11 @@ struct NameDict {
     float _load_factor;
     uint16_t _hash_seed;
     uint16_t _mask;
+    // for the dict of a type, value writes and changes to the dicts of its base classes draw
+    // a fresh version too, which makes it the version tag of the type's attribute lookups
+    uint32_t _version;
+    bool _is_type_attr = false;
+    std::vector<NameDict*>* _subclasses = nullptr;     // dicts of the direct subclasses of a type
     StrName* _keys;
 
     inline PyVar& value(uint16_t i){
@@ -85,7 +95,7 @@ struct NameDict {
 
     NameDict(uint16_t capacity=2, float load_factor=0.67, uint16_t hash_seed=kHashSeeds[0]):
         _capacity(capacity), _size(0), _load_factor(load_factor),
-        _hash_seed(hash_seed), _mask(capacity-1) {
+        _hash_seed(hash_seed), _mask(capacity-1), _version(++kNameDictVersion) {
             _keys = _dict_pool.alloc(capacity);
         }
 
@@ -96,9 +106,14 @@ struct NameDict {
             _keys[i] = other._keys[i];
             value(i) = other.value(i);
         }
+        _is_type_attr = false;
+        _subclasses = nullptr;
+        _version = ++kNameDictVersion;
     }
 
     NameDict& operator=(const NameDict& other) {
+        bool is_type_attr = _is_type_attr;
+        std::vector<NameDict*>* subclasses = _subclasses;
         _dict_pool.dealloc(_keys, _capacity);
         memcpy(this, &other, sizeof(NameDict));
         _keys = _dict_pool.alloc(_capacity);
@@ -106,15 +121,34 @@ struct NameDict {
             _keys[i] = other._keys[i];
             value(i) = other.value(i);
         }
+        _is_type_attr = is_type_attr;
+        _subclasses = subclasses;
+        _bump_version();
         return *this;
     }
     
-    ~NameDict(){ _dict_pool.dealloc(_keys, _capacity); }
+    ~NameDict(){
+        _dict_pool.dealloc(_keys, _capacity);
+        delete _subclasses;
+    }
 
     NameDict(NameDict&&) = delete;
     NameDict& operator=(NameDict&&) = delete;
     uint16_t size() const { return _size; }
 
+    // subclasses look attributes up through this dict, so their version tags change with it
+    void _bump_version(){
+        _version = ++kNameDictVersion;
+        if(_subclasses != nullptr){
+            for(NameDict* d: *_subclasses) d->_bump_version();
+        }
+    }
+
+    void _add_subclass(NameDict* d){
+        if(_subclasses == nullptr) _subclasses = new std::vector<NameDict*>();
+        _subclasses->push_back(d);
+    }
+
 #define HASH_PROBE(key, ok, i) \
 ok = false; \
 i = _hash(key, _mask, _hash_seed); \
@@ -148,6 +182,9 @@ while(!_keys[i].empty()) { \
                 HASH_PROBE(key, ok, i);
             }
             _keys[i] = key;
+            _bump_version();
+        }else if(_is_type_attr){
+            _bump_version();
         }
         value(i) = std::forward<T>(val);
     }
@@ -170,6 +207,7 @@ while(!_keys[i].empty()) { \
             value(j) = old_values[i]; // std::move makes a segfault
         }
         _dict_pool.dealloc(old_keys, old_capacity);
+        _bump_version();
     }
 
     void _try_perfect_rehash(){
@@ -184,10 +222,21 @@ while(!_keys[i].empty()) { \
         return &value(i);
     }
 
+    // probes the slot remembered in `hint` first, for callers that cache it
+    inline PyVar* try_get_hinted(StrName key, uint16_t& hint){
+        if(hint < _capacity && _keys[hint] == key) return &value(hint);
+        bool ok; uint16_t i;
+        HASH_PROBE(key, ok, i);
+        if(!ok) return nullptr;
+        hint = i;
+        return &value(i);
+    }
+
     inline bool try_set(StrName key, PyVar&& val){
         bool ok; uint16_t i;
         HASH_PROBE(key, ok, i);
         if(!ok) return false;
+        if(_is_type_attr) _bump_version();
         value(i) = std::move(val);
         return true;
     }
@@ -211,6 +260,23 @@ while(!_keys[i].empty()) { \
         if(!ok) throw std::out_of_range("NameDict key not found: " + key.str());
         _keys[i] = StrName(); value(i).reset();
         _size--;
+        _bump_version();
+    }
+
+    template<typename F>
+    void apply_values(F f) const {
+        for(uint16_t i=0; i<_capacity; i++){
+            if(!_keys[i].empty()) f(value(i));
+        }
+    }
+
+    void clear(){
+        for(uint16_t i=0; i<_capacity; i++){
+            _keys[i] = StrName();
+            value(i).reset();
+        }
+        _size = 0;
+        _bump_version();
     }
 
     std::vector<std::pair<StrName, PyVar>> items() const {
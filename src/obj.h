@@ -2,6 +2,7 @@
 
 #include "common.h"
 #include "namedict.h"
+#include "shape.h"
 #include "tuplelist.h"
 #include <type_traits>
 
@@ -12,17 +13,31 @@ struct Frame;
 struct BaseRef;
 class VM;
 
-typedef std::function<PyVar(VM*, Args&)> NativeFuncRaw;
+typedef std::function<PyVar(VM*, ArgsView)> NativeFuncRaw;
+typedef std::vector<std::pair<StrName, PyVar>> NativeKwargs;
 typedef shared_ptr<CodeObject> CodeObject_;
 typedef shared_ptr<NameDict> NameDict_;
 
+// receives the references an object owns, for the cycle collector in gc.h
+struct GCVisitor {
+    virtual void visit(PyObject* obj) = 0;
+    inline void operator()(const PyVar& v){
+        if(v != nullptr && !v.is_tagged()) visit(v.get());
+    }
+};
+
 struct NativeFunc {
     NativeFuncRaw f;
     int argc;       // DONOT include self
     bool method;
+    // keyword parameters with their defaults, a nullptr default means "not given";
+    // their values are passed after the positional arguments, in this order
+    NativeKwargs kwargs;
     
-    NativeFunc(NativeFuncRaw f, int argc, bool method) : f(f), argc(argc), method(method) {}
-    inline PyVar operator()(VM* vm, Args& args) const;
+    NativeFunc(NativeFuncRaw f, int argc, bool method, NativeKwargs kwargs={})
+        : f(f), argc(argc), method(method), kwargs(std::move(kwargs)) {}
+    inline PyVar operator()(VM* vm, ArgsView args) const;
+    PyVar call_kw(VM* vm, ArgsView args, const Args& kwargs) const;
 };
 
 struct Function {
@@ -37,6 +52,21 @@ struct Function {
     PyVar _module = nullptr;
     NameDict_ _closure = nullptr;
 
+    // a closure shared with other functions or a live frame counts as a reference from outside
+    void _gc_traverse(GCVisitor& v) const {
+        v(_module);
+        kwargs.apply_values([&](const PyVar& val){ v(val); });
+        if(_closure != nullptr && _closure.use_count() == 1){
+            _closure->apply_values([&](const PyVar& val){ v(val); });
+        }
+    }
+
+    void _gc_clear(){
+        _module.reset();
+        _closure.reset();
+        kwargs.clear();
+    }
+
     bool has_name(StrName val) const {
         bool _0 = std::find(args.begin(), args.end(), val) != args.end();
         bool _1 = starred_arg == val;
@@ -49,6 +79,83 @@ struct BoundMethod {
     PyVar obj;
     PyVar method;
     BoundMethod(const PyVar& obj, const PyVar& method) : obj(obj), method(method) {}
+
+    void _gc_traverse(GCVisitor& v) const { v(obj); v(method); }
+    void _gc_clear(){ obj.reset(); method.reset(); }
+};
+
+// the payload of instances of user classes: the values of the attributes, by their slot in
+// `shape`. The first kInlineSlots are in the object, which then fills a 96-byte block.
+// In dictionary mode (shape == kDictShape) the attributes are in `_dict` instead.
+struct DummyInstance {
+    static const int kInlineSlots = 5;
+
+    uint32_t shape = ShapeTable::kEmpty;
+    uint32_t _overflow_capacity = 0;
+    union {
+        PyVar* _overflow = nullptr;
+        NameDict* _dict;
+    };
+    PyVar _inline[kInlineSlots];
+
+    DummyInstance() = default;
+    DummyInstance(const DummyInstance&) = delete;
+    DummyInstance(DummyInstance&& other) noexcept : shape(other.shape), _overflow_capacity(other._overflow_capacity), _overflow(other._overflow) {
+        for(int i=0; i<kInlineSlots; i++) _inline[i] = std::move(other._inline[i]);
+        other.shape = ShapeTable::kEmpty;
+        other._overflow_capacity = 0;
+        other._overflow = nullptr;
+    }
+    ~DummyInstance(){
+        if(is_dict_mode()) delete _dict;
+        else delete[] _overflow;
+    }
+
+    inline bool is_dict_mode() const { return shape == kDictShape; }
+
+    // moves the `size` slots into a NameDict keyed by `names`
+    void _to_dict_mode(const std::vector<StrName>& names, int size){
+        NameDict* dict = new NameDict(8, kInstAttrLoadFactor);
+        for(int i=0; i<size; i++) dict->set(names[i], std::move(slot(i)));
+        delete[] _overflow;
+        _overflow_capacity = 0;
+        _dict = dict;
+        shape = kDictShape;
+    }
+
+    inline PyVar& slot(int i){
+        return i < kInlineSlots ? _inline[i] : _overflow[i - kInlineSlots];
+    }
+
+    void reserve(int n){
+        if(n <= kInlineSlots + (int)_overflow_capacity) return;
+        uint32_t capacity = std::max<uint32_t>(_overflow_capacity * 2, 4);
+        while(kInlineSlots + capacity < n) capacity *= 2;
+        PyVar* overflow = new PyVar[capacity];
+        for(uint32_t i=0; i<_overflow_capacity; i++) overflow[i] = std::move(_overflow[i]);
+        delete[] _overflow;
+        _overflow = overflow;
+        _overflow_capacity = capacity;
+    }
+
+    void _gc_traverse(GCVisitor& v) const {
+        if(is_dict_mode()){
+            _dict->apply_values([&](const PyVar& val){ v(val); });
+            return;
+        }
+        for(int i=0; i<kInlineSlots; i++) v(_inline[i]);
+        for(uint32_t i=0; i<_overflow_capacity; i++) v(_overflow[i]);
+    }
+
+    void _gc_clear(){
+        if(is_dict_mode()){
+            _dict->clear();
+            return;
+        }
+        shape = ShapeTable::kEmpty;
+        for(int i=0; i<kInlineSlots; i++) _inline[i].reset();
+        for(uint32_t i=0; i<_overflow_capacity; i++) _overflow[i].reset();
+    }
 };
 
 struct Range {
@@ -82,43 +189,199 @@ protected:
     PyVar _ref;     // keep a reference to the object so it will not be deleted while iterating
 public:
     virtual PyVar next() = 0;
-    PyVarRef loop_var;
+    inline const PyVar& ref() const noexcept { return _ref; }
     BaseIter(VM* vm, PyVar _ref) : vm(vm), _ref(_ref) {}
     virtual ~BaseIter() = default;
 };
 
+struct GCHead;
+
+// the header of every object: 8 bytes after the size class and counter that SpAllocator puts
+// before it. There is no vtable, a header names its payload type with `_kind` and objects
+// are destroyed and traversed through _py_kinds. Payloads that need them get the attribute
+// table and the links of the cycle collector right after the header, in that order.
 struct PyObject {
+    static const uint16_t kHasAttr = 1;
+    static const uint16_t kGCTracked = 2;
+    static const uint16_t kHasShape = 4;     // a DummyInstance, its attributes are in slots
+
     Type type;
-    NameDict* _attr;
+    uint16_t _kind;
+    uint16_t _flags;
 
-    inline bool is_attr_valid() const noexcept { return _attr != nullptr; }
-    inline NameDict& attr() noexcept { return *_attr; }
-    inline const PyVar& attr(StrName name) const noexcept { return _attr->get(name); }
-    virtual void* value() = 0;
+    PyObject(Type type, uint16_t kind, uint16_t flags) : type(type), _kind(kind), _flags(flags) {}
+
+    // the `_attr` of PyHeader, valid when kHasAttr is set
+    inline NameDict* _attr_ptr() const noexcept {
+        return *reinterpret_cast<NameDict* const*>(reinterpret_cast<const char*>(this) + sizeof(PyObject));
+    }
+    inline bool is_attr_valid() const noexcept { return _flags & kHasAttr; }
+    inline bool has_shape() const noexcept { return _flags & kHasShape; }
+    inline void* value();    // the payload, for callers that only know a base class of it
+    inline NameDict& attr() noexcept { return *_attr_ptr(); }
+    inline const PyVar& attr(StrName name) const noexcept { return _attr_ptr()->get(name); }
+
+    // nullptr if the object is not tracked by the cycle collector
+    inline GCHead* _gc_head() noexcept {
+        if(!(_flags & kGCTracked)) return nullptr;
+        size_t offset = sizeof(PyObject) + ((_flags & kHasAttr) ? sizeof(NameDict*) : 0);
+        return reinterpret_cast<GCHead*>(reinterpret_cast<char*>(this) + offset);
+    }
+};
 
-    PyObject(Type type) : type(type) {}
-    virtual ~PyObject() { delete _attr; }
+// the links of a tracked object in a generation list of the VM's CycleCollector;
+// unlinking needs no list head, so an object can leave its list when it is destroyed
+struct GCLink {
+    GCLink* _gc_prev = nullptr;
+    GCLink* _gc_next = nullptr;
+
+    inline void _gc_unlink(){
+        if(_gc_prev == nullptr) return;
+        _gc_prev->_gc_next = _gc_next;
+        _gc_next->_gc_prev = _gc_prev;
+        _gc_prev = _gc_next = nullptr;
+    }
 };
 
+struct GCHead : GCLink {
+    int _gc_refs = -1;      // scratch of the cycle collector, -1 outside a collection
+    int _offset;            // of this head in its object
+
+    inline PyObject* _obj() noexcept {
+        return reinterpret_cast<PyObject*>(reinterpret_cast<char*>(this) - _offset);
+    }
+};
+
+// what is done to an object through its `_kind`, in place of virtual functions
+struct PyKindInfo {
+    void (*destroy)(PyObject*);
+    void* (*value)(PyObject*);
+    void (*gc_traverse)(PyObject*, GCVisitor&);     // nullptr for untracked kinds
+    void (*gc_clear)(PyObject*);
+    size_t size;
+};
+
+// constant-initialized, so objects can be destroyed at any point of the program
+inline PyKindInfo _py_kinds[256];
+inline std::atomic<int> _py_num_kinds{0};
+
+inline uint16_t _register_kind(const PyKindInfo& info){
+    int kind = _py_num_kinds++;
+    if(kind >= 256) throw std::runtime_error("too many payload types");
+    _py_kinds[kind] = info;
+    return kind;
+}
+
+inline void* PyObject::value(){ return _py_kinds[_kind].value(this); }
+
+inline void _py_destroy(PyObject* obj){
+    _py_kinds[obj->_kind].destroy(obj);
+}
+
+// the objects of a VM that skip refcounting: they live until the VM is destroyed, which
+// is when this is destroyed too, after every member of the VM that could reference them
+struct ImmortalObjects {
+    std::vector<int*> _counters;
+
+    void add(const PyVar& obj){
+        if(obj == nullptr || obj.is_tagged() || obj.is_immortal()) return;
+        *obj.counter = kImmortalRefs;
+        _counters.push_back(obj.counter);
+    }
+
+    ~ImmortalObjects(){
+        // the references among them are not counted, so no block is released before all are destroyed
+        for(int* c: _counters) _py_destroy((PyObject*)(c + 1));
+        for(int* c: _counters) pool.dealloc(c);
+    }
+};
+
+// a payload takes part in cycle collection by defining
+// `void _gc_traverse(GCVisitor&) const` and `void _gc_clear()`
+template <typename, typename = void> struct has_gc_hooks : std::false_type {};
+template <typename T> struct has_gc_hooks<T, std::void_t<decltype(&T::_gc_traverse)>> : std::true_type {};
+
+// types and modules are never freed, so they are not tracked
+template <typename T>
+inline constexpr bool is_gc_tracked_v = has_gc_hooks<T>::value ||
+    std::is_same_v<T, List> || std::is_same_v<T, Tuple>;
+
+template <typename T>
+inline constexpr bool has_attr_v = std::is_same_v<T, Type> || std::is_same_v<T, DummyModule> ||
+    std::is_same_v<T, Function> || std::is_same_v<T, NativeFunc>;
+
+template<bool kAttr, bool kGC> struct PyHeader;
+template<> struct PyHeader<false, false> : PyObject { using PyObject::PyObject; };
+template<> struct PyHeader<true, false> : PyObject { NameDict* _attr; using PyObject::PyObject; };
+template<> struct PyHeader<false, true> : PyObject { GCHead _gc; using PyObject::PyObject; };
+template<> struct PyHeader<true, true> : PyObject { NameDict* _attr; GCHead _gc; using PyObject::PyObject; };
+
+static_assert(sizeof(PyObject) == 8);
+static_assert(sizeof(PyHeader<true, false>) == 16);
+static_assert(sizeof(PyHeader<false, true>) == 32);
+static_assert(sizeof(PyHeader<true, true>) == 40);
+
 template <typename T>
-struct Py_ : PyObject {
-    T _value;
+struct Py_ : PyHeader<has_attr_v<T>, is_gc_tracked_v<T>> {
+    using Base = PyHeader<has_attr_v<T>, is_gc_tracked_v<T>>;
+    static const uint16_t kFlags = (has_attr_v<T> ? PyObject::kHasAttr : 0) | (is_gc_tracked_v<T> ? PyObject::kGCTracked : 0) |
+        (std::is_same_v<T, DummyInstance> ? PyObject::kHasShape : 0);
+    PK_NO_UNIQUE_ADDRESS T _value;      // an empty payload takes no space
+
+    Py_(Type type, const T& val): Base(type, _kind(), kFlags), _value(val) { _init(); }
+    Py_(Type type, T&& val): Base(type, _kind(), kFlags), _value(std::move(val)) { _init(); }
+
+    ~Py_(){
+        if constexpr(has_attr_v<T>) delete this->_attr;
+        if constexpr(is_gc_tracked_v<T>) this->_gc._gc_unlink();
+    }
 
-    Py_(Type type, const T& val): PyObject(type), _value(val) { _init(); }
-    Py_(Type type, T&& val): PyObject(type), _value(std::move(val)) { _init(); }
+    static uint16_t _kind(){
+        static const uint16_t kind = _register_kind(PyKindInfo{
+            [](PyObject* p){ static_cast<Py_*>(p)->~Py_(); },
+            [](PyObject* p) -> void* { return &static_cast<Py_*>(p)->_value; },
+            is_gc_tracked_v<T> ? &Py_::_gc_traverse : nullptr,
+            is_gc_tracked_v<T> ? &Py_::_gc_clear : nullptr,
+            sizeof(Py_)
+        });
+        return kind;
+    }
 
     inline void _init() noexcept {
-        if constexpr (std::is_same_v<T, Type> || std::is_same_v<T, DummyModule>) {
-            _attr = new NameDict(8, kTypeAttrLoadFactor);
-        }else if constexpr(std::is_same_v<T, DummyInstance>){
-            _attr = new NameDict(8, kInstAttrLoadFactor);
-        }else if constexpr(std::is_same_v<T, Function> || std::is_same_v<T, NativeFunc>){
-            _attr = new NameDict(8, kInstAttrLoadFactor);
-        }else{
-            _attr = nullptr;
+        if constexpr (std::is_same_v<T, Type>) {
+            this->_attr = new NameDict(8, kTypeAttrLoadFactor);
+            this->_attr->_is_type_attr = true;
+        }else if constexpr(std::is_same_v<T, DummyModule>){
+            this->_attr = new NameDict(8, kTypeAttrLoadFactor);
+        }else if constexpr(has_attr_v<T>){
+            this->_attr = new NameDict(8, kInstAttrLoadFactor);
+        }
+        if constexpr(is_gc_tracked_v<T>){
+            this->_gc._offset = reinterpret_cast<char*>(&this->_gc) - reinterpret_cast<char*>(static_cast<PyObject*>(this));
+        }
+    }
+
+    static void _gc_traverse(PyObject* p, GCVisitor& v) {
+        Py_* self = static_cast<Py_*>(p);
+        if constexpr(has_attr_v<T>) self->_attr->apply_values([&](const PyVar& val){ v(val); });
+        if constexpr(std::is_same_v<T, List> || std::is_same_v<T, Tuple>){
+            for(int i=0; i<self->_value.size(); i++) v(self->_value[i]);
+        }else if constexpr(has_gc_hooks<T>::value){
+            self->_value._gc_traverse(v);
+        }
+    }
+
+    static void _gc_clear(PyObject* p) {
+        Py_* self = static_cast<Py_*>(p);
+        if constexpr(has_attr_v<T>) self->_attr->clear();
+        if constexpr(std::is_same_v<T, List>){
+            self->_value.clear();
+        }else if constexpr(std::is_same_v<T, Tuple>){
+            for(int i=0; i<self->_value.size(); i++) self->_value[i].reset();
+        }else if constexpr(has_gc_hooks<T>::value){
+            self->_value._gc_clear();
         }
     }
-    void* value() override { return &_value; }
 };
 
 #define OBJ_GET(T, obj) (((Py_<T>*)((obj).get()))->_value)
@@ -1,12 +1,16 @@
 #ifdef OPCODE
 
 OPCODE(NO_OP)
+OPCODE(END_OF_CODE)
 OPCODE(POP_TOP)
 OPCODE(DUP_TOP_VALUE)
+OPCODE(DUP_TOP_TWO)
 OPCODE(CALL)
 OPCODE(CALL_UNPACK)
 OPCODE(CALL_KWARGS)
 OPCODE(CALL_KWARGS_UNPACK)
+OPCODE(LOAD_METHOD)
+OPCODE(CALL_METHOD)
 OPCODE(RETURN_VALUE)
 OPCODE(ROT_TWO)
 
@@ -27,6 +31,7 @@ OPCODE(BUILD_SLICE)
 OPCODE(BUILD_TUPLE)
 OPCODE(BUILD_TUPLE_REF)
 OPCODE(BUILD_STRING)
+OPCODE(UNPACK_SEQUENCE)
 
 OPCODE(LIST_APPEND)
 OPCODE(MAP_ADD)
@@ -59,6 +64,7 @@ OPCODE(LOAD_FUNCTION)
 OPCODE(LOAD_ELLIPSIS)
 OPCODE(LOAD_NAME)
 OPCODE(LOAD_NAME_REF)
+OPCODE(LOAD_FAST)
 
 OPCODE(ASSERT)
 OPCODE(EXCEPTION_MATCH)
@@ -69,17 +75,19 @@ OPCODE(BUILD_INDEX)
 OPCODE(BUILD_ATTR)
 OPCODE(BUILD_ATTR_REF)
 OPCODE(STORE_NAME)
-OPCODE(STORE_FUNCTION)
+OPCODE(STORE_FAST)
+OPCODE(STORE_ATTR)
+OPCODE(STORE_SUBSCR)
 OPCODE(STORE_REF)
+OPCODE(DELETE_NAME)
+OPCODE(DELETE_FAST)
+OPCODE(DELETE_ATTR)
+OPCODE(DELETE_SUBSCR)
 OPCODE(DELETE_REF)
 
-OPCODE(TRY_BLOCK_ENTER)
-OPCODE(TRY_BLOCK_EXIT)
-
 OPCODE(YIELD_VALUE)
 
 OPCODE(FAST_INDEX)      // a[x]
-OPCODE(FAST_INDEX_REF)       // a[x]
 
 OPCODE(INPLACE_BINARY_OP)
 OPCODE(INPLACE_BITWISE_OP)
@@ -92,4 +100,18 @@ OPCODE(BEGIN_CLASS)
 OPCODE(END_CLASS)
 OPCODE(STORE_CLASS_ATTR)
 
+// specialized forms installed by quickening, each falls back to its generic form
+OPCODE(BINARY_ADD_INT)
+OPCODE(BINARY_SUB_INT)
+OPCODE(BINARY_MUL_INT)
+OPCODE(BINARY_ADD_FLOAT)
+OPCODE(BINARY_SUB_FLOAT)
+OPCODE(BINARY_MUL_FLOAT)
+OPCODE(COMPARE_OP_INT)
+OPCODE(COMPARE_OP_FLOAT)
+OPCODE(BUILD_ATTR_INSTANCE)
+OPCODE(INDEX_LIST_INT)
+OPCODE(CALL_PY_EXACT_ARGS)
+OPCODE(FOR_ITER_RANGE)
+
 #endif
\ No newline at end of file
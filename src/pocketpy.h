@@ -6,6 +6,7 @@
 #include "iter.h"
 #include "cffi.h"
 #include "io.h"
+#include "timsort.h"
 #include "_generated.h"
 
 namespace pkpy {
@@ -22,7 +23,7 @@ CodeObject_ VM::compile(Str source, Str filename, CompileMode mode) {
 }
 
 #define BIND_NUM_ARITH_OPT(name, op)                                                                    \
-    _vm->_bind_methods<1>({"int","float"}, #name, [](VM* vm, Args& args){                         \
+    _vm->_bind_methods<1>({"int","float"}, #name, [](VM* vm, ArgsView args){                         \
         if(is_both_int(args[0], args[1])){                                                              \
             return VAR(_CAST(i64, args[0]) op _CAST(i64, args[1]));                     \
         }else{                                                                                          \
@@ -31,7 +32,7 @@ CodeObject_ VM::compile(Str source, Str filename, CompileMode mode) {
     });
 
 #define BIND_NUM_LOGICAL_OPT(name, op, is_eq)                                                           \
-    _vm->_bind_methods<1>({"int","float"}, #name, [](VM* vm, Args& args){                         \
+    _vm->_bind_methods<1>({"int","float"}, #name, [](VM* vm, ArgsView args){                         \
         if(!is_both_int_or_float(args[0], args[1])){                                                    \
             if constexpr(is_eq) return VAR(args[0] op args[1]);                                  \
             vm->TypeError("unsupported operand type(s) for " #op );                                     \
@@ -42,6 +43,253 @@ CodeObject_ VM::compile(Str source, Str filename, CompileMode mode) {
     });
     
 
+// the byte length of the line break str.splitlines() finds at `p`, 0 if there is none:
+// \n, \r, \r\n, \v, \f, \x1c-\x1e, \x85, \u2028 and \u2029
+inline int _line_break_len(const char* p, const char* end){
+    unsigned char c = *p;
+    if(c == '\r') return (p + 1 < end && p[1] == '\n') ? 2 : 1;
+    if(c == '\n' || c == '\v' || c == '\f' || (c >= 0x1c && c <= 0x1e)) return 1;
+    if(c == 0xC2) return (p + 1 < end && (unsigned char)p[1] == 0x85) ? 2 : 0;
+    if(c == 0xE2 && p + 2 < end && (unsigned char)p[1] == 0x80) return ((unsigned char)p[2] == 0xA8 || (unsigned char)p[2] == 0xA9) ? 3 : 0;
+    return 0;
+}
+
+// sorts (key, value) pairs by key; reversing before and after keeps equal keys in their original order
+template<typename K, typename Less>
+void _sort_by_keys(List& values, std::vector<K>& keys, bool reverse, Less less){
+    struct Entry { K key; PyVar value; };
+    std::vector<Entry> entries;
+    entries.reserve(values.size());
+    for(int i=0; i<values.size(); i++) entries.push_back(Entry{std::move(keys[i]), values[i]});
+    if(reverse) std::reverse(entries.begin(), entries.end());
+    timsort(entries.data(), entries.size(), [&](const Entry& a, const Entry& b){ return less(a.key, b.key); });
+    if(reverse) std::reverse(entries.begin(), entries.end());
+    for(int i=0; i<values.size(); i++) values[i] = std::move(entries[i].value);
+}
+
+inline void _sort_values(VM* vm, List& values, const PyVar& key, bool reverse){
+    std::vector<PyVar> keys;
+    keys.reserve(values.size());
+    for(const PyVar& v: values) keys.push_back(key == vm->None ? v : vm->call(key, one_arg(v)));
+
+    // typed keys are compared without dispatch
+    bool all_int = true, all_float = true, all_str = true;
+    for(const PyVar& k: keys){
+        all_int = all_int && is_int(k);
+        all_float = all_float && is_float(k);
+        all_str = all_str && is_type(k, vm->tp_str);
+    }
+    if(all_int){
+        std::vector<i64> ks;
+        for(const PyVar& k: keys) ks.push_back(_CAST(i64, k));
+        _sort_by_keys(values, ks, reverse, std::less<i64>());
+    }else if(all_float){
+        std::vector<f64> ks;
+        for(const PyVar& k: keys) ks.push_back(_CAST(f64, k));
+        _sort_by_keys(values, ks, reverse, std::less<f64>());
+    }else if(all_str){
+        std::vector<const Str*> ks;
+        for(const PyVar& k: keys) ks.push_back(&_CAST(Str&, k));
+        _sort_by_keys(values, ks, reverse, [](const Str* a, const Str* b){ return *a < *b; });
+    }else{
+        std::vector<PyVar> ks = keys;
+        _sort_by_keys(values, ks, reverse, [vm](const PyVar& a, const PyVar& b){ return vm->py_less(a, b); });
+    }
+}
+
+// like CPython, `self` is empty while `key` and `<` run, so any change they make to it is found;
+// an exception from them leaves `self` as it was
+inline void list_sort(VM* vm, List& self, const PyVar& key, bool reverse){
+    List values = std::move(self);
+    self.clear();
+    try{
+        _sort_values(vm, values, key, reverse);
+    }catch(...){
+        self = std::move(values);
+        throw;
+    }
+    bool modified = !self.empty();
+    self = std::move(values);
+    if(modified) vm->ValueError("list modified during sort");
+}
+
+// args are the positional arguments followed by key= and default=, the latter nullptr if not given
+inline PyVar _builtin_min_max(VM* vm, ArgsView args, bool is_max){
+    int n = args.size() - 2;
+    const PyVar& key = args[n];
+    const PyVar& default_ = args[n+1];
+    Str name = is_max ? "max()" : "min()";
+    if(n == 0) vm->TypeError(name + " expected at least 1 argument, got 0");
+    PyVar best = nullptr;
+    PyVar best_key = nullptr;
+    // the first of several equal candidates wins, like in CPython
+    auto visit = [&](const PyVar& obj){
+        PyVar k = key == vm->None ? obj : vm->call(key, one_arg(obj));
+        if(best == nullptr || (is_max ? vm->py_less(best_key, k) : vm->py_less(k, best_key))){
+            best = obj;
+            best_key = std::move(k);
+        }
+    };
+    if(n == 1){
+        PyVar iter = vm->asIter(args[0]);
+        BaseIter* it = vm->PyIter_AS_C(iter);
+        for(PyVar obj = it->next(); obj != nullptr; obj = it->next()) visit(obj);
+        if(best == nullptr){
+            if(default_ == nullptr) vm->ValueError(name + " arg is an empty sequence");
+            return default_;
+        }
+    }else{
+        if(default_ != nullptr) vm->TypeError("cannot specify a default for " + name + " with multiple positional arguments");
+        for(int i=0; i<n; i++) visit(args[i]);
+    }
+    return best;
+}
+
+// the bytes of self[start:end] for the optional start and end arguments of str.find() and friends,
+// first > second if the range lies past the end
+inline std::pair<size_t, size_t> _str_byte_range(VM* vm, const Str& self, const PyVar& start, const PyVar& end){
+    if(start == vm->None && end == vm->None) return {0, self.size()};
+    i64 n = self.u8_length();
+    i64 s = start == vm->None ? 0 : CAST(i64, start);
+    i64 e = end == vm->None ? n : CAST(i64, end);
+    if(s < 0) s = std::max<i64>(s + n, 0);
+    if(e < 0) e = std::max<i64>(e + n, 0);
+    if(s > n || e < s) return {self.size() + 1, self.size()};
+    if(e > n) e = n;
+    return {self.u8_byte_offset(s), self.u8_byte_offset(e)};
+}
+
+// -1 if `sub` is not in self[start:end]
+inline i64 _str_find(VM* vm, ArgsView args){
+    const Str& self = CAST(Str&, args[0]);
+    const Str& sub = CAST(Str&, args[1]);
+    auto r = _str_byte_range(vm, self, args[2], args[3]);
+    size_t pos = str_find(self.data(), r.second, sub.data(), sub.size(), r.first);
+    if(pos == Str::npos) return -1;
+    return self._to_u8_index(pos);
+}
+
+inline i64 _str_rfind(VM* vm, ArgsView args){
+    const Str& self = CAST(Str&, args[0]);
+    const Str& sub = CAST(Str&, args[1]);
+    auto r = _str_byte_range(vm, self, args[2], args[3]);
+    if(r.first > r.second) return -1;
+    size_t pos = std::string_view(self.data(), r.second).rfind(sub);
+    if(pos == Str::npos || pos < r.first) return -1;
+    return self._to_u8_index(pos);
+}
+
+// `sep` None splits on runs of whitespace and drops empty parts
+inline List _str_split(VM* vm, const Str& self, const PyVar& sep, i64 maxsplit){
+    List ret;
+    const char* p = self.data();
+    const char* end = p + self.size();
+    if(sep == vm->None){
+        while(true){
+            p = skip_space(p, end);
+            if(p == end) break;
+            if(maxsplit == 0){
+                ret.push_back(VAR(Str(p, end - p)));
+                break;
+            }
+            const char* q = find_space(p, end);
+            ret.push_back(VAR(Str(p, q - p)));
+            p = q;
+            maxsplit--;
+        }
+        return ret;
+    }
+    const Str& s = CAST(Str&, sep);
+    if(s.empty()) vm->ValueError("empty separator");
+    size_t pos = 0;
+    for(; maxsplit != 0; maxsplit--){
+        size_t q = str_find(self.data(), self.size(), s.data(), s.size(), pos);
+        if(q == Str::npos) break;
+        ret.push_back(VAR(Str(p + pos, q - pos)));
+        pos = q + s.size();
+    }
+    ret.push_back(VAR(Str(p + pos, self.size() - pos)));
+    return ret;
+}
+
+inline List _str_rsplit(VM* vm, const Str& self, const PyVar& sep, i64 maxsplit){
+    if(maxsplit < 0) return _str_split(vm, self, sep, maxsplit);
+    List ret;
+    const char* begin = self.data();
+    if(sep == vm->None){
+        const char* q = begin + self.size();
+        while(true){
+            while(q > begin && is_space_char(q[-1])) q--;
+            if(q == begin) break;
+            if(maxsplit == 0){
+                ret.push_back(VAR(Str(begin, q - begin)));
+                break;
+            }
+            const char* p = q;
+            while(p > begin && !is_space_char(p[-1])) p--;
+            ret.push_back(VAR(Str(p, q - p)));
+            q = p;
+            maxsplit--;
+        }
+    }else{
+        const Str& s = CAST(Str&, sep);
+        if(s.empty()) vm->ValueError("empty separator");
+        std::string_view view(self);
+        size_t end = self.size();
+        for(; maxsplit != 0 && end >= s.size(); maxsplit--){
+            size_t q = view.rfind(s, end - s.size());
+            if(q == Str::npos) break;
+            ret.push_back(VAR(Str(begin + q + s.size(), end - q - s.size())));
+            end = q;
+        }
+        ret.push_back(VAR(Str(begin, end)));
+    }
+    std::reverse(ret.begin(), ret.end());
+    return ret;
+}
+
+// `chars` None strips whitespace, otherwise any of its code points
+inline Str _str_strip(VM* vm, const Str& self, const PyVar& chars, bool left, bool right){
+    const char* begin = self.data();
+    const char* end = begin + self.size();
+    if(chars == vm->None){
+        if(left) begin = skip_space(begin, end);
+        if(right) while(end > begin && is_space_char(end[-1])) end--;
+        return Str(begin, end - begin);
+    }
+    const Str& cs = CAST(Str&, chars);
+    if(is_ascii(cs.data(), cs.size())){
+        // UTF-8 sequences contain no ASCII bytes, so bytes can be matched one by one
+        bool table[256] = {false};
+        for(char c: cs) table[(unsigned char)c] = true;
+        if(left) while(begin < end && table[(unsigned char)*begin]) begin++;
+        if(right) while(end > begin && table[(unsigned char)end[-1]]) end--;
+        return Str(begin, end - begin);
+    }
+    auto in_chars = [&](const char* p, size_t len){
+        for(size_t i=0; i<cs.size(); i+=utf8_lead_len(cs[i])){
+            if(std::string_view(cs.data() + i, std::min<size_t>(utf8_lead_len(cs[i]), cs.size() - i)) == std::string_view(p, len)) return true;
+        }
+        return false;
+    };
+    if(left){
+        while(begin < end){
+            size_t len = std::min<size_t>(utf8_lead_len(*begin), end - begin);
+            if(!in_chars(begin, len)) break;
+            begin += len;
+        }
+    }
+    if(right){
+        while(end > begin){
+            const char* p = end - 1;
+            while(p > begin && (*p & 0xC0) == 0x80) p--;
+            if(!in_chars(p, end - p)) break;
+            end = p;
+        }
+    }
+    return Str(begin, end - begin);
+}
+
 void init_builtins(VM* _vm) {
     BIND_NUM_ARITH_OPT(__add__, +)
     BIND_NUM_ARITH_OPT(__sub__, -)
@@ -57,12 +305,21 @@ void init_builtins(VM* _vm) {
 #undef BIND_NUM_ARITH_OPT
 #undef BIND_NUM_LOGICAL_OPT
 
-    _vm->bind_builtin_func<1>("__sys_stdout_write", [](VM* vm, Args& args) {
-        (*vm->_stdout) << CAST(Str&, args[0]);
+    _vm->bind_builtin_func<-1>("print", [](VM* vm, ArgsView args) {
+        int n = args.size() - 2;
+        const PyVar& sep = args[n];
+        const PyVar& end = args[n+1];
+        StrStream ss;
+        for(int i=0; i<n; i++){
+            if(i > 0) ss << (sep == vm->None ? " " : CAST(Str&, sep));
+            ss << CAST(Str&, vm->asStr(args[i]));
+        }
+        ss << (end == vm->None ? "\n" : CAST(Str&, end));
+        (*vm->_stdout) << ss.str();
         return vm->None;
-    });
+    }, {{"sep", py_var(_vm, " ")}, {"end", py_var(_vm, "\n")}});
 
-    _vm->bind_builtin_func<2>("super", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<2>("super", [](VM* vm, ArgsView args) {
         vm->check_type(args[0], vm->tp_type);
         Type type = OBJ_GET(Type, args[0]);
         if(!vm->isinstance(args[1], type)){
@@ -72,37 +329,42 @@ void init_builtins(VM* _vm) {
         return vm->new_object(vm->tp_super, Super(args[1], base));
     });
 
-    _vm->bind_builtin_func<2>("isinstance", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<2>("isinstance", [](VM* vm, ArgsView args) {
         vm->check_type(args[1], vm->tp_type);
         Type type = OBJ_GET(Type, args[1]);
         return VAR(vm->isinstance(args[0], type));
     });
 
-    _vm->bind_builtin_func<1>("id", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<1>("id", [](VM* vm, ArgsView args) {
         const PyVar& obj = args[0];
         if(obj.is_tagged()) return VAR((i64)0);
         return VAR(obj.bits);
     });
 
-    _vm->bind_builtin_func<2>("divmod", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<2>("divmod", [](VM* vm, ArgsView args) {
         i64 lhs = CAST(i64, args[0]);
         i64 rhs = CAST(i64, args[1]);
         if(rhs == 0) vm->ZeroDivisionError();
         return VAR(two_args(VAR(lhs/rhs), VAR(lhs%rhs)));
     });
 
-    _vm->bind_builtin_func<1>("eval", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<1>("eval", [](VM* vm, ArgsView args) {
         CodeObject_ code = vm->compile(CAST(Str&, args[0]), "<eval>", EVAL_MODE);
-        return vm->_exec(code, vm->top_frame()->_module, vm->top_frame()->_locals);
+        Frame* frame = vm->top_frame();
+        PyVar ret = vm->_exec(code, frame->_module, frame->locals_dict());
+        frame->sync_fast_locals();
+        return ret;
     });
 
-    _vm->bind_builtin_func<1>("exec", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<1>("exec", [](VM* vm, ArgsView args) {
         CodeObject_ code = vm->compile(CAST(Str&, args[0]), "<exec>", EXEC_MODE);
-        vm->_exec(code, vm->top_frame()->_module, vm->top_frame()->_locals);
+        Frame* frame = vm->top_frame();
+        vm->_exec(code, frame->_module, frame->locals_dict());
+        frame->sync_fast_locals();
         return vm->None;
     });
 
-    _vm->bind_builtin_func<-1>("exit", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<-1>("exit", [](VM* vm, ArgsView args) {
         if(args.size() == 0) std::exit(0);
         else if(args.size() == 1) std::exit(CAST(int, args[0]));
         else vm->TypeError("exit() takes at most 1 argument");
@@ -112,54 +374,126 @@ void init_builtins(VM* _vm) {
     _vm->bind_builtin_func<1>("repr", CPP_LAMBDA(vm->asRepr(args[0])));
     _vm->bind_builtin_func<1>("len", CPP_LAMBDA(vm->call(args[0], __len__, no_arg())));
 
-    _vm->bind_builtin_func<1>("hash", [](VM* vm, Args& args){
+    _vm->bind_builtin_func<1>("hash", [](VM* vm, ArgsView args){
         i64 value = vm->hash(args[0]);
         if(((value << 2) >> 2) != value) value >>= 2;
         return VAR(value);
     });
 
-    _vm->bind_builtin_func<1>("chr", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<1>("chr", [](VM* vm, ArgsView args) {
         i64 i = CAST(i64, args[0]);
         if (i < 0 || i > 128) vm->ValueError("chr() arg not in range(128)");
         return VAR(std::string(1, (char)i));
     });
 
-    _vm->bind_builtin_func<1>("ord", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<1>("ord", [](VM* vm, ArgsView args) {
         const Str& s = CAST(Str&, args[0]);
         if (s.size() != 1) vm->TypeError("ord() expected an ASCII character");
         return VAR((i64)(s.c_str()[0]));
     });
 
-    _vm->bind_builtin_func<2>("hasattr", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<2>("hasattr", [](VM* vm, ArgsView args) {
         return VAR(vm->getattr(args[0], CAST(Str&, args[1]), false) != nullptr);
     });
 
-    _vm->bind_builtin_func<3>("setattr", [](VM* vm, Args& args) {
-        vm->setattr(args[0], CAST(Str&, args[1]), args[2]);
+    _vm->bind_builtin_func<3>("setattr", [](VM* vm, ArgsView args) {
+        PyVar obj = args[0];
+        vm->setattr(obj, CAST(Str&, args[1]), args[2]);
         return vm->None;
     });
 
-    _vm->bind_builtin_func<2>("getattr", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<2>("getattr", [](VM* vm, ArgsView args) {
         const Str& name = CAST(Str&, args[1]);
         return vm->getattr(args[0], name);
     });
 
-    _vm->bind_builtin_func<1>("hex", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<1>("hex", [](VM* vm, ArgsView args) {
         std::stringstream ss;
         ss << std::hex << CAST(i64, args[0]);
         return VAR("0x" + ss.str());
     });
 
-    _vm->bind_builtin_func<1>("iter", [](VM* vm, Args& args) {
+    _vm->bind_builtin_func<1>("iter", [](VM* vm, ArgsView args) {
         return vm->asIter(args[0]);
     });
 
-    _vm->bind_builtin_func<1>("dir", [](VM* vm, Args& args) {
-        std::set<StrName> names;
-        if(args[0]->is_attr_valid()){
-            std::vector<StrName> keys = args[0]->attr().keys();
-            names.insert(keys.begin(), keys.end());
+    _vm->bind_builtin_func<1>("abs", [](VM* vm, ArgsView args) {
+        if(is_int(args[0])) return VAR(std::abs(_CAST(i64, args[0])));
+        if(is_float(args[0])) return VAR(std::fabs(_CAST(f64, args[0])));
+        vm->TypeError("bad operand type for abs(): " + OBJ_NAME(vm->_t(args[0])).escape(true));
+        return vm->None;
+    });
+
+    _vm->bind_builtin_func<-1>("min", CPP_LAMBDA(_builtin_min_max(vm, args, false)), {{"key", _vm->None}, {"default", nullptr}});
+    _vm->bind_builtin_func<-1>("max", CPP_LAMBDA(_builtin_min_max(vm, args, true)), {{"key", _vm->None}, {"default", nullptr}});
+
+    _vm->bind_builtin_func<1>("sum", [](VM* vm, ArgsView args) {
+        PyVar ret = args[1];
+        PyVar iter = vm->asIter(args[0]);
+        BaseIter* it = vm->PyIter_AS_C(iter);
+        for(PyVar obj = it->next(); obj != nullptr; obj = it->next()){
+            PyVarOrNull val = vm->_fast_binary_op(0, ret, obj);
+            ret = val != nullptr ? val : vm->fast_call(BINARY_SPECIAL_METHODS[0], two_args(ret, obj));
+        }
+        return ret;
+    }, {{"start", py_var(_vm, (i64)0)}});
+
+    _vm->bind_builtin_func<1>("all", [](VM* vm, ArgsView args) {
+        PyVar iter = vm->asIter(args[0]);
+        BaseIter* it = vm->PyIter_AS_C(iter);
+        for(PyVar obj = it->next(); obj != nullptr; obj = it->next()){
+            if(vm->asBool(obj) == vm->False) return vm->False;
         }
+        return vm->True;
+    });
+
+    _vm->bind_builtin_func<1>("any", [](VM* vm, ArgsView args) {
+        PyVar iter = vm->asIter(args[0]);
+        BaseIter* it = vm->PyIter_AS_C(iter);
+        for(PyVar obj = it->next(); obj != nullptr; obj = it->next()){
+            if(vm->asBool(obj) == vm->True) return vm->True;
+        }
+        return vm->False;
+    });
+
+    _vm->bind_builtin_func<1>("enumerate", [](VM* vm, ArgsView args) {
+        return vm->PyIter(EnumerateIter(vm, vm->asIter(args[0]), CAST(i64, args[1])));
+    }, {{"start", py_var(_vm, (i64)0)}});
+
+    _vm->bind_builtin_func<-1>("zip", [](VM* vm, ArgsView args) {
+        std::vector<PyVar> iters;
+        for(const PyVar& obj: args) iters.push_back(vm->asIter(obj));
+        return vm->PyIter(ZipIter(vm, std::move(iters)));
+    });
+
+    _vm->bind_builtin_func<-1>("map", [](VM* vm, ArgsView args) {
+        if(args.size() < 2) vm->TypeError("map() must have at least two arguments");
+        std::vector<PyVar> iters;
+        for(int i=1; i<args.size(); i++) iters.push_back(vm->asIter(args[i]));
+        return vm->PyIter(MapIter(vm, args[0], std::move(iters)));
+    });
+
+    _vm->bind_builtin_func<2>("filter", [](VM* vm, ArgsView args) {
+        return vm->PyIter(FilterIter(vm, args[0], vm->asIter(args[1])));
+    });
+
+    // returns a list rather than an iterator, as it always has here
+    _vm->bind_builtin_func<1>("reversed", [](VM* vm, ArgsView args) {
+        List ret = CAST(List&, vm->asList(args[0]));
+        std::reverse(ret.begin(), ret.end());
+        return VAR(std::move(ret));
+    });
+
+    _vm->bind_builtin_func<1>("sorted", [](VM* vm, ArgsView args) {
+        List ret = CAST(List&, vm->asList(args[0]));
+        list_sort(vm, ret, args[1], vm->asBool(args[2]) == vm->True);
+        return VAR(std::move(ret));
+    }, {{"key", _vm->None}, {"reverse", _vm->False}});
+
+    _vm->bind_builtin_func<1>("dir", [](VM* vm, ArgsView args) {
+        std::set<StrName> names;
+        std::vector<StrName> own = vm->_own_attr_names(args[0]);
+        names.insert(own.begin(), own.end());
         const NameDict& t_attr = vm->_t(args[0])->attr();
         std::vector<StrName> keys = t_attr.keys();
         names.insert(keys.begin(), keys.end());
@@ -168,7 +502,7 @@ void init_builtins(VM* _vm) {
         return VAR(std::move(ret));
     });
 
-    _vm->bind_method<0>("object", "__repr__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("object", "__repr__", [](VM* vm, ArgsView args) {
         PyVar self = args[0];
         std::uintptr_t addr = self.is_tagged() ? 0 : (uintptr_t)self.get();
         StrStream ss;
@@ -181,7 +515,7 @@ void init_builtins(VM* _vm) {
     _vm->bind_method<1>("object", "__ne__", CPP_LAMBDA(VAR(args[0] != args[1])));
 
     _vm->bind_static_method<1>("type", "__new__", CPP_LAMBDA(vm->_t(args[0])));
-    _vm->bind_static_method<-1>("range", "__new__", [](VM* vm, Args& args) {
+    _vm->bind_static_method<-1>("range", "__new__", [](VM* vm, ArgsView args) {
         Range r;
         switch (args.size()) {
             case 1: r.stop = CAST(i64, args[0]); break;
@@ -199,13 +533,13 @@ void init_builtins(VM* _vm) {
     _vm->bind_method<0>("NoneType", "__repr__", CPP_LAMBDA(VAR("None")));
     _vm->bind_method<0>("NoneType", "__json__", CPP_LAMBDA(VAR("null")));
 
-    _vm->_bind_methods<1>({"int", "float"}, "__truediv__", [](VM* vm, Args& args) {
+    _vm->_bind_methods<1>({"int", "float"}, "__truediv__", [](VM* vm, ArgsView args) {
         f64 rhs = vm->num_to_float(args[1]);
         if (rhs == 0) vm->ZeroDivisionError();
         return VAR(vm->num_to_float(args[0]) / rhs);
     });
 
-    _vm->_bind_methods<1>({"int", "float"}, "__pow__", [](VM* vm, Args& args) {
+    _vm->_bind_methods<1>({"int", "float"}, "__pow__", [](VM* vm, ArgsView args) {
         if(is_both_int(args[0], args[1])){
             i64 lhs = _CAST(i64, args[0]);
             i64 rhs = _CAST(i64, args[1]);
@@ -225,7 +559,7 @@ void init_builtins(VM* _vm) {
     });
 
     /************ PyInt ************/
-    _vm->bind_static_method<1>("int", "__new__", [](VM* vm, Args& args) {
+    _vm->bind_static_method<1>("int", "__new__", [](VM* vm, ArgsView args) {
         if (is_type(args[0], vm->tp_int)) return args[0];
         if (is_type(args[0], vm->tp_float)) return VAR((i64)CAST(f64, args[0]));
         if (is_type(args[0], vm->tp_bool)) return VAR(_CAST(bool, args[0]) ? 1 : 0);
@@ -244,13 +578,13 @@ void init_builtins(VM* _vm) {
         return vm->None;
     });
 
-    _vm->bind_method<1>("int", "__floordiv__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("int", "__floordiv__", [](VM* vm, ArgsView args) {
         i64 rhs = CAST(i64, args[1]);
         if(rhs == 0) vm->ZeroDivisionError();
         return VAR(CAST(i64, args[0]) / rhs);
     });
 
-    _vm->bind_method<1>("int", "__mod__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("int", "__mod__", [](VM* vm, ArgsView args) {
         i64 rhs = CAST(i64, args[1]);
         if(rhs == 0) vm->ZeroDivisionError();
         return VAR(CAST(i64, args[0]) % rhs);
@@ -271,7 +605,7 @@ void init_builtins(VM* _vm) {
 #undef INT_BITWISE_OP
 
     /************ PyFloat ************/
-    _vm->bind_static_method<1>("float", "__new__", [](VM* vm, Args& args) {
+    _vm->bind_static_method<1>("float", "__new__", [](VM* vm, ArgsView args) {
         if (is_type(args[0], vm->tp_int)) return VAR((f64)CAST(i64, args[0]));
         if (is_type(args[0], vm->tp_float)) return args[0];
         if (is_type(args[0], vm->tp_bool)) return VAR(_CAST(bool, args[0]) ? 1.0 : 0.0);
@@ -290,7 +624,7 @@ void init_builtins(VM* _vm) {
         return vm->None;
     });
 
-    _vm->bind_method<0>("float", "__repr__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("float", "__repr__", [](VM* vm, ArgsView args) {
         f64 val = CAST(f64, args[0]);
         if(std::isinf(val) || std::isnan(val)) return VAR(std::to_string(val));
         StrStream ss;
@@ -300,7 +634,7 @@ void init_builtins(VM* _vm) {
         return VAR(s);
     });
 
-    _vm->bind_method<0>("float", "__json__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("float", "__json__", [](VM* vm, ArgsView args) {
         f64 val = CAST(f64, args[0]);
         if(std::isinf(val) || std::isnan(val)) vm->ValueError("cannot jsonify 'nan' or 'inf'");
         return VAR(std::to_string(val));
@@ -309,49 +643,58 @@ void init_builtins(VM* _vm) {
     /************ PyString ************/
     _vm->bind_static_method<1>("str", "__new__", CPP_LAMBDA(vm->asStr(args[0])));
 
-    _vm->bind_method<1>("str", "__add__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("str", "__add__", [](VM* vm, ArgsView args) {
         const Str& lhs = CAST(Str&, args[0]);
         const Str& rhs = CAST(Str&, args[1]);
         return VAR(lhs + rhs);
     });
 
-    _vm->bind_method<0>("str", "__len__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("str", "__len__", [](VM* vm, ArgsView args) {
         const Str& self = CAST(Str&, args[0]);
         return VAR(self.u8_length());
     });
 
-    _vm->bind_method<1>("str", "__contains__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("str", "__contains__", [](VM* vm, ArgsView args) {
         const Str& self = CAST(Str&, args[0]);
         const Str& other = CAST(Str&, args[1]);
-        return VAR(self.find(other) != Str::npos);
+        return VAR(str_find(self.data(), self.size(), other.data(), other.size()) != Str::npos);
+    });
+
+    _vm->bind_method<1>("str", "__mul__", [](VM* vm, ArgsView args) {
+        const Str& self = CAST(Str&, args[0]);
+        i64 n = CAST(i64, args[1]);
+        Str ret;
+        if(n > 0) ret.reserve(self.size() * n);
+        for(i64 i=0; i<n; i++) ret.append(self);
+        return VAR(std::move(ret));
     });
 
     _vm->bind_method<0>("str", "__str__", CPP_LAMBDA(args[0]));
     _vm->bind_method<0>("str", "__iter__", CPP_LAMBDA(vm->PyIter(StringIter(vm, args[0]))));
 
-    _vm->bind_method<0>("str", "__repr__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("str", "__repr__", [](VM* vm, ArgsView args) {
         const Str& _self = CAST(Str&, args[0]);
         return VAR(_self.escape(true));
     });
 
-    _vm->bind_method<0>("str", "__json__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("str", "__json__", [](VM* vm, ArgsView args) {
         const Str& self = CAST(Str&, args[0]);
         return VAR(self.escape(false));
     });
 
-    _vm->bind_method<1>("str", "__eq__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("str", "__eq__", [](VM* vm, ArgsView args) {
         if(is_type(args[0], vm->tp_str) && is_type(args[1], vm->tp_str))
             return VAR(CAST(Str&, args[0]) == CAST(Str&, args[1]));
         return VAR(args[0] == args[1]);
     });
 
-    _vm->bind_method<1>("str", "__ne__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("str", "__ne__", [](VM* vm, ArgsView args) {
         if(is_type(args[0], vm->tp_str) && is_type(args[1], vm->tp_str))
             return VAR(CAST(Str&, args[0]) != CAST(Str&, args[1]));
         return VAR(args[0] != args[1]);
     });
 
-    _vm->bind_method<1>("str", "__getitem__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("str", "__getitem__", [](VM* vm, ArgsView args) {
         const Str& self (CAST(Str&, args[0]));
 
         if(is_type(args[1], vm->tp_slice)){
@@ -362,47 +705,160 @@ void init_builtins(VM* _vm) {
 
         int index = CAST(int, args[1]);
         index = vm->normalized_index(index, self.u8_length());
+        if(self.is_ascii()) return vm->_ascii_str_pool[(unsigned char)self[index]];
         return VAR(self.u8_getitem(index));
     });
 
-    _vm->bind_method<1>("str", "__gt__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("str", "__gt__", [](VM* vm, ArgsView args) {
         const Str& self (CAST(Str&, args[0]));
         const Str& obj (CAST(Str&, args[1]));
         return VAR(self > obj);
     });
 
-    _vm->bind_method<1>("str", "__lt__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("str", "__lt__", [](VM* vm, ArgsView args) {
         const Str& self (CAST(Str&, args[0]));
         const Str& obj (CAST(Str&, args[1]));
         return VAR(self < obj);
     });
 
-    _vm->bind_method<2>("str", "replace", [](VM* vm, Args& args) {
-        const Str& _self = CAST(Str&, args[0]);
-        const Str& _old = CAST(Str&, args[1]);
-        const Str& _new = CAST(Str&, args[2]);
-        Str _copy = _self;
+    _vm->bind_method<2>("str", "replace", [](VM* vm, ArgsView args) {
+        const Str& self = CAST(Str&, args[0]);
+        const Str& old = CAST(Str&, args[1]);
+        const Str& new_ = CAST(Str&, args[2]);
+        i64 count = CAST(i64, args[3]);
+        Str ret;
+        if(old.empty()){
+            // new_ goes before every code point and at the end
+            for(size_t i=0; ; ){
+                if(count != 0){ ret.append(new_); count--; }
+                if(i >= self.size()) break;
+                size_t len = std::min<size_t>(utf8_lead_len(self[i]), self.size() - i);
+                ret.append(self, i, len);
+                i += len;
+            }
+            return VAR(std::move(ret));
+        }
         size_t pos = 0;
-        while ((pos = _copy.find(_old, pos)) != std::string::npos) {
-            _copy.replace(pos, _old.length(), _new);
-            pos += _new.length();
+        for(; count != 0; count--){
+            size_t q = str_find(self.data(), self.size(), old.data(), old.size(), pos);
+            if(q == Str::npos) break;
+            ret.append(self, pos, q - pos);
+            ret.append(new_);
+            pos = q + old.size();
         }
-        return VAR(_copy);
-    });
+        if(pos == 0) return args[0];
+        ret.append(self, pos, self.size() - pos);
+        return VAR(std::move(ret));
+    }, {{"count", py_var(_vm, (i64)-1)}});
 
-    _vm->bind_method<1>("str", "startswith", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("str", "startswith", [](VM* vm, ArgsView args) {
         const Str& self = CAST(Str&, args[0]);
         const Str& prefix = CAST(Str&, args[1]);
-        return VAR(self.find(prefix) == 0);
+        return VAR(self.compare(0, prefix.size(), prefix) == 0);
     });
 
-    _vm->bind_method<1>("str", "endswith", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("str", "endswith", [](VM* vm, ArgsView args) {
         const Str& self = CAST(Str&, args[0]);
         const Str& suffix = CAST(Str&, args[1]);
-        return VAR(self.rfind(suffix) == self.length() - suffix.length());
+        if(suffix.size() > self.size()) return vm->False;
+        return VAR(self.compare(self.size() - suffix.size(), suffix.size(), suffix) == 0);
+    });
+
+    // start and end are code point indices, like the slice self[start:end]
+    NativeKwargs str_range = {{"start", _vm->None}, {"end", _vm->None}};
+
+    _vm->bind_method<1>("str", "find", CPP_LAMBDA(VAR(_str_find(vm, args))), str_range);
+    _vm->bind_method<1>("str", "rfind", CPP_LAMBDA(VAR(_str_rfind(vm, args))), str_range);
+
+    _vm->bind_method<1>("str", "index", [](VM* vm, ArgsView args) {
+        i64 pos = _str_find(vm, args);
+        if(pos == -1) vm->ValueError("substring not found");
+        return VAR(pos);
+    }, str_range);
+
+    _vm->bind_method<1>("str", "count", [](VM* vm, ArgsView args) {
+        const Str& self = CAST(Str&, args[0]);
+        const Str& sub = CAST(Str&, args[1]);
+        auto r = _str_byte_range(vm, self, args[2], args[3]);
+        if(r.first > r.second) return VAR(0);
+        if(sub.empty()) return VAR((i64)utf8_count(self.data() + r.first, r.second - r.first) + 1);
+        i64 count = 0;
+        size_t pos = r.first;
+        while((pos = str_find(self.data(), r.second, sub.data(), sub.size(), pos)) != Str::npos){
+            count++;
+            pos += sub.size();
+        }
+        return VAR(count);
+    }, str_range);
+
+    NativeKwargs split_args = {{"sep", _vm->None}, {"maxsplit", py_var(_vm, (i64)-1)}};
+
+    _vm->bind_method<0>("str", "split", [](VM* vm, ArgsView args) {
+        return VAR(_str_split(vm, CAST(Str&, args[0]), args[1], CAST(i64, args[2])));
+    }, split_args);
+
+    _vm->bind_method<0>("str", "rsplit", [](VM* vm, ArgsView args) {
+        return VAR(_str_rsplit(vm, CAST(Str&, args[0]), args[1], CAST(i64, args[2])));
+    }, split_args);
+
+    _vm->bind_method<0>("str", "splitlines", [](VM* vm, ArgsView args) {
+        const Str& self = CAST(Str&, args[0]);
+        bool keepends = vm->asBool(args[1]) == vm->True;
+        const char* p = self.data();
+        const char* end = p + self.size();
+        List ret;
+        while(p < end){
+            const char* q = p;
+            int brk = 0;    // byte length of the line break at q
+            for(; q < end; q++){
+                brk = _line_break_len(q, end);
+                if(brk != 0) break;
+            }
+            const char* next = q + brk;
+            ret.push_back(VAR(Str(p, (keepends ? next : q) - p)));
+            p = next;
+        }
+        return VAR(std::move(ret));
+    }, {{"keepends", _vm->False}});
+
+    NativeKwargs strip_args = {{"chars", _vm->None}};
+
+    _vm->bind_method<0>("str", "strip", CPP_LAMBDA(VAR(_str_strip(vm, CAST(Str&, args[0]), args[1], true, true))), strip_args);
+    _vm->bind_method<0>("str", "lstrip", CPP_LAMBDA(VAR(_str_strip(vm, CAST(Str&, args[0]), args[1], true, false))), strip_args);
+    _vm->bind_method<0>("str", "rstrip", CPP_LAMBDA(VAR(_str_strip(vm, CAST(Str&, args[0]), args[1], false, true))), strip_args);
+
+    _vm->bind_method<1>("str", "partition", [](VM* vm, ArgsView args) {
+        const Str& self = CAST(Str&, args[0]);
+        const Str& sep = CAST(Str&, args[1]);
+        if(sep.empty()) vm->ValueError("empty separator");
+        size_t pos = str_find(self.data(), self.size(), sep.data(), sep.size());
+        Args ret(3);
+        if(pos == Str::npos){
+            ret[0] = args[0];
+            ret[1] = ret[2] = VAR("");
+        }else{
+            ret[0] = VAR(Str(self.data(), pos));
+            ret[1] = args[1];
+            ret[2] = VAR(Str(self.data() + pos + sep.size(), self.size() - pos - sep.size()));
+        }
+        return VAR(std::move(ret));
+    });
+
+    _vm->bind_method<0>("str", "upper", [](VM* vm, ArgsView args) {
+        const Str& self = CAST(Str&, args[0]);
+        Str ret(self.data(), self.size());
+        if(!ascii_case(&ret[0], ret.size(), true)) return VAR(Str(unicode_case(self.data(), self.size(), true)));
+        return VAR(std::move(ret));
+    });
+
+    _vm->bind_method<0>("str", "lower", [](VM* vm, ArgsView args) {
+        const Str& self = CAST(Str&, args[0]);
+        Str ret(self.data(), self.size());
+        if(!ascii_case(&ret[0], ret.size(), false)) return VAR(Str(unicode_case(self.data(), self.size(), false)));
+        return VAR(std::move(ret));
     });
 
-    _vm->bind_method<1>("str", "join", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("str", "join", [](VM* vm, ArgsView args) {
         const Str& self = CAST(Str&, args[0]);
         StrStream ss;
         PyVar obj = vm->asList(args[1]);
@@ -415,13 +871,13 @@ void init_builtins(VM* _vm) {
     });
 
     /************ PyList ************/
-    _vm->bind_method<1>("list", "append", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("list", "append", [](VM* vm, ArgsView args) {
         List& self = CAST(List&, args[0]);
         self.push_back(args[1]);
         return vm->None;
     });
 
-    _vm->bind_method<1>("list", "extend", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("list", "extend", [](VM* vm, ArgsView args) {
         List& self = CAST(List&, args[0]);
         PyVar obj = vm->asList(args[1]);
         const List& list = CAST(List&, obj);
@@ -429,13 +885,18 @@ void init_builtins(VM* _vm) {
         return vm->None;
     });
 
-    _vm->bind_method<0>("list", "reverse", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("list", "sort", [](VM* vm, ArgsView args) {
+        list_sort(vm, CAST(List&, args[0]), args[1], vm->asBool(args[2]) == vm->True);
+        return vm->None;
+    }, {{"key", _vm->None}, {"reverse", _vm->False}});
+
+    _vm->bind_method<0>("list", "reverse", [](VM* vm, ArgsView args) {
         List& self = CAST(List&, args[0]);
         std::reverse(self.begin(), self.end());
         return vm->None;
     });
 
-    _vm->bind_method<1>("list", "__mul__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("list", "__mul__", [](VM* vm, ArgsView args) {
         const List& self = CAST(List&, args[0]);
         int n = CAST(int, args[1]);
         List result;
@@ -444,7 +905,7 @@ void init_builtins(VM* _vm) {
         return VAR(std::move(result));
     });
 
-    _vm->bind_method<2>("list", "insert", [](VM* vm, Args& args) {
+    _vm->bind_method<2>("list", "insert", [](VM* vm, ArgsView args) {
         List& self = CAST(List&, args[0]);
         int index = CAST(int, args[1]);
         if(index < 0) index += self.size();
@@ -454,14 +915,14 @@ void init_builtins(VM* _vm) {
         return vm->None;
     });
 
-    _vm->bind_method<0>("list", "clear", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("list", "clear", [](VM* vm, ArgsView args) {
         CAST(List&, args[0]).clear();
         return vm->None;
     });
 
     _vm->bind_method<0>("list", "copy", CPP_LAMBDA(VAR(CAST(List, args[0]))));
 
-    _vm->bind_method<1>("list", "__add__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("list", "__add__", [](VM* vm, ArgsView args) {
         const List& self = CAST(List&, args[0]);
         const List& obj = CAST(List&, args[1]);
         List new_list = self;
@@ -469,16 +930,16 @@ void init_builtins(VM* _vm) {
         return VAR(new_list);
     });
 
-    _vm->bind_method<0>("list", "__len__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("list", "__len__", [](VM* vm, ArgsView args) {
         const List& self = CAST(List&, args[0]);
         return VAR(self.size());
     });
 
-    _vm->bind_method<0>("list", "__iter__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("list", "__iter__", [](VM* vm, ArgsView args) {
         return vm->PyIter(ArrayIter<List>(vm, args[0]));
     });
 
-    _vm->bind_method<1>("list", "__getitem__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("list", "__getitem__", [](VM* vm, ArgsView args) {
         const List& self = CAST(List&, args[0]);
 
         if(is_type(args[1], vm->tp_slice)){
@@ -494,7 +955,7 @@ void init_builtins(VM* _vm) {
         return self[index];
     });
 
-    _vm->bind_method<2>("list", "__setitem__", [](VM* vm, Args& args) {
+    _vm->bind_method<2>("list", "__setitem__", [](VM* vm, ArgsView args) {
         List& self = CAST(List&, args[0]);
         int index = CAST(int, args[1]);
         index = vm->normalized_index(index, self.size());
@@ -502,7 +963,7 @@ void init_builtins(VM* _vm) {
         return vm->None;
     });
 
-    _vm->bind_method<1>("list", "__delitem__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("list", "__delitem__", [](VM* vm, ArgsView args) {
         List& self = CAST(List&, args[0]);
         int index = CAST(int, args[1]);
         index = vm->normalized_index(index, self.size());
@@ -511,16 +972,16 @@ void init_builtins(VM* _vm) {
     });
 
     /************ PyTuple ************/
-    _vm->bind_static_method<1>("tuple", "__new__", [](VM* vm, Args& args) {
+    _vm->bind_static_method<1>("tuple", "__new__", [](VM* vm, ArgsView args) {
         List list = CAST(List, vm->asList(args[0]));
         return VAR(Tuple::from_list(std::move(list)));
     });
 
-    _vm->bind_method<0>("tuple", "__iter__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("tuple", "__iter__", [](VM* vm, ArgsView args) {
         return vm->PyIter(ArrayIter<Args>(vm, args[0]));
     });
 
-    _vm->bind_method<1>("tuple", "__getitem__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("tuple", "__getitem__", [](VM* vm, ArgsView args) {
         const Tuple& self = CAST(Tuple&, args[0]);
 
         if(is_type(args[1], vm->tp_slice)){
@@ -536,25 +997,309 @@ void init_builtins(VM* _vm) {
         return self[index];
     });
 
-    _vm->bind_method<0>("tuple", "__len__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("tuple", "__len__", [](VM* vm, ArgsView args) {
         const Tuple& self = CAST(Tuple&, args[0]);
         return VAR(self.size());
     });
 
+    /************ PyDict ************/
+    _vm->bind_static_method<-1>("dict", "__new__", [](VM* vm, ArgsView args) {
+        Dict dict;
+        if(args.size() > 1) vm->TypeError("dict() takes at most 1 argument");
+        if(args.size() == 1){
+            if(is_type(args[0], vm->tp_dict)){
+                dict = _CAST(Dict&, args[0]);
+            }else{
+                PyVar iter = vm->asIter(args[0]);
+                BaseIter* it = vm->PyIter_AS_C(iter);
+                for(PyVar item = it->next(); item != nullptr; item = it->next()){
+                    PyVar pair = vm->asList(item);
+                    const List& kv = CAST(List&, pair);
+                    if(kv.size() != 2) vm->ValueError("dict() expects an iterable of key-value pairs");
+                    dict.set(vm, kv[0], kv[1]);
+                }
+            }
+        }
+        return VAR(std::move(dict));
+    });
+
+    _vm->bind_method<0>("dict", "__len__", CPP_LAMBDA(VAR(CAST(Dict&, args[0]).size())));
+
+    _vm->bind_method<1>("dict", "__getitem__", [](VM* vm, ArgsView args) {
+        Dict& self = CAST(Dict&, args[0]);
+        PyVar* val = self.try_get(vm, args[1]);
+        if(val == nullptr) vm->_error("KeyError", CAST(Str, vm->asRepr(args[1])));
+        return *val;
+    });
+
+    _vm->bind_method<2>("dict", "__setitem__", [](VM* vm, ArgsView args) {
+        CAST(Dict&, args[0]).set(vm, args[1], args[2]);
+        return vm->None;
+    });
+
+    _vm->bind_method<1>("dict", "__delitem__", [](VM* vm, ArgsView args) {
+        bool ok = CAST(Dict&, args[0]).erase(vm, args[1]);
+        if(!ok) vm->_error("KeyError", CAST(Str, vm->asRepr(args[1])));
+        return vm->None;
+    });
+
+    _vm->bind_method<1>("dict", "__contains__", CPP_LAMBDA(VAR(CAST(Dict&, args[0]).contains(vm, args[1]))));
+
+    _vm->bind_method<0>("dict", "__iter__", [](VM* vm, ArgsView args) {
+        const Dict& self = CAST(Dict&, args[0]);
+        return vm->PyIter(DictIter(vm, args[0], &self, DICT_KEYS));
+    });
+
+    _vm->bind_method<-1>("dict", "get", [](VM* vm, ArgsView args) {
+        Dict& self = CAST(Dict&, args[0]);
+        if(args.size() != 2 && args.size() != 3) vm->TypeError("get() takes 1 or 2 arguments");
+        PyVar* val = self.try_get(vm, args[1]);
+        if(val != nullptr) return *val;
+        return args.size() == 3 ? args[2] : vm->None;
+    });
+
+    _vm->bind_method<0>("dict", "keys", [](VM* vm, ArgsView args) {
+        vm->check_type(args[0], vm->tp_dict);
+        return vm->new_object(vm->tp_dict_keys, DictView{args[0], DICT_KEYS});
+    });
+
+    _vm->bind_method<0>("dict", "values", [](VM* vm, ArgsView args) {
+        vm->check_type(args[0], vm->tp_dict);
+        return vm->new_object(vm->tp_dict_values, DictView{args[0], DICT_VALUES});
+    });
+
+    _vm->bind_method<0>("dict", "items", [](VM* vm, ArgsView args) {
+        vm->check_type(args[0], vm->tp_dict);
+        return vm->new_object(vm->tp_dict_items, DictView{args[0], DICT_ITEMS});
+    });
+
+    _vm->bind_method<0>("dict", "clear", [](VM* vm, ArgsView args) {
+        CAST(Dict&, args[0]).clear();
+        return vm->None;
+    });
+
+    _vm->bind_method<1>("dict", "update", [](VM* vm, ArgsView args) {
+        Dict& self = CAST(Dict&, args[0]);
+        self.update(vm, CAST(Dict&, args[1]));
+        return vm->None;
+    });
+
+    _vm->bind_method<0>("dict", "copy", CPP_LAMBDA(VAR(CAST(Dict, args[0]))));
+
+    _vm->bind_method<0>("dict", "__repr__", [](VM* vm, ArgsView args) {
+        const Dict& self = CAST(Dict&, args[0]);
+        StrStream ss;
+        ss << "{";
+        bool first = true;
+        for(const Dict::Item& item: self._items){
+            if(item.first == nullptr) continue;
+            if(!first) ss << ", ";
+            first = false;
+            ss << CAST(Str&, vm->asRepr(item.first)) << ": " << CAST(Str&, vm->asRepr(item.second));
+        }
+        ss << "}";
+        return VAR(ss.str());
+    });
+
+    _vm->bind_method<0>("dict", "__json__", [](VM* vm, ArgsView args) {
+        const Dict& self = CAST(Dict&, args[0]);
+        StrStream ss;
+        ss << "{";
+        bool first = true;
+        for(const Dict::Item& item: self._items){
+            if(item.first == nullptr) continue;
+            if(!is_type(item.first, vm->tp_str)){
+                vm->TypeError("json keys must be strings, got " + CAST(Str&, vm->asRepr(item.first)));
+            }
+            if(!first) ss << ", ";
+            first = false;
+            ss << CAST(Str&, vm->call(item.first, __json__)) << ": " << CAST(Str&, vm->call(item.second, __json__));
+        }
+        ss << "}";
+        return VAR(ss.str());
+    });
+
+    _vm->bind_method<1>("dict", "__eq__", [](VM* vm, ArgsView args) {
+        const Dict& self = CAST(Dict&, args[0]);
+        if(!is_type(args[1], vm->tp_dict)) return vm->False;
+        Dict& other = _CAST(Dict&, args[1]);
+        if(self.size() != other.size()) return vm->False;
+        for(const Dict::Item& item: self._items){
+            if(item.first == nullptr) continue;
+            PyVar* val = other.try_get(vm, item.first);
+            if(val == nullptr || !vm->py_equals(item.second, *val)) return vm->False;
+        }
+        return vm->True;
+    });
+
+    _vm->bind_method<1>("dict", "__ne__", [](VM* vm, ArgsView args) {
+        return VAR(!CAST(bool, vm->fast_call(__eq__, two_args(args[0], args[1]))));
+    });
+
+    for(const char* name: {"dict_keys", "dict_values", "dict_items"}){
+        _vm->bind_method<0>(name, "__iter__", [](VM* vm, ArgsView args) {
+            const DictView& view = OBJ_GET(DictView, args[0]);
+            return vm->PyIter(DictIter(vm, view.dict, &OBJ_GET(Dict, view.dict), view.kind));
+        });
+
+        _vm->bind_method<0>(name, "__len__", [](VM* vm, ArgsView args) {
+            const DictView& view = OBJ_GET(DictView, args[0]);
+            return VAR(OBJ_GET(Dict, view.dict).size());
+        });
+
+        _vm->bind_method<0>(name, "__repr__", [](VM* vm, ArgsView args) {
+            const DictView& view = OBJ_GET(DictView, args[0]);
+            PyVar list = vm->asList(args[0]);
+            Str name = OBJ_NAME(vm->_t(args[0]));
+            return VAR(name + "(" + CAST(Str&, vm->asRepr(list)) + ")");
+        });
+    }
+
+    _vm->bind_method<1>("dict_keys", "__contains__", [](VM* vm, ArgsView args) {
+        const DictView& view = OBJ_GET(DictView, args[0]);
+        return VAR(OBJ_GET(Dict, view.dict).contains(vm, args[1]));
+    });
+
+    /************ PySet ************/
+    _vm->bind_static_method<-1>("set", "__new__", [](VM* vm, ArgsView args) {
+        if(args.size() > 1) vm->TypeError("set() takes at most 1 argument");
+        Set set;
+        if(args.size() == 1) set = _as_set(vm, args[0], set);
+        return vm->new_object(vm->tp_set, std::move(set));
+    });
+
+    _vm->bind_static_method<-1>("frozenset", "__new__", [](VM* vm, ArgsView args) {
+        if(args.size() > 1) vm->TypeError("frozenset() takes at most 1 argument");
+        if(args.size() == 1 && is_type(args[0], vm->tp_frozenset)) return args[0];
+        Set set;
+        if(args.size() == 1) set = _as_set(vm, args[0], set);
+        return vm->new_object(vm->tp_frozenset, std::move(set));
+    });
+
+    // methods shared by set and frozenset, new sets have the type of the left operand
+    std::vector<Str> set_types = {"set", "frozenset"};
+
+    _vm->_bind_methods<0>(set_types, "__len__", CPP_LAMBDA(VAR(_check_set(vm, args[0]).size())));
+    _vm->_bind_methods<1>(set_types, "__contains__", CPP_LAMBDA(VAR(_check_set(vm, args[0]).contains(vm, args[1]))));
+
+    _vm->_bind_methods<0>(set_types, "__iter__", [](VM* vm, ArgsView args) {
+        const Set& self = _check_set(vm, args[0]);
+        return vm->PyIter(DictIter(vm, args[0], &self._table, DICT_KEYS));
+    });
+
+    _vm->_bind_methods<0>(set_types, "copy", [](VM* vm, ArgsView args) {
+        return vm->new_object(args[0]->type, _check_set(vm, args[0]));
+    });
+
+    _vm->_bind_methods<0>(set_types, "__repr__", [](VM* vm, ArgsView args) {
+        const Set& self = _check_set(vm, args[0]);
+        bool frozen = is_type(args[0], vm->tp_frozenset);
+        if(self.size() == 0) return VAR(frozen ? "frozenset()" : "set()");
+        StrStream ss;
+        if(frozen) ss << "frozenset(";
+        ss << "{";
+        bool first = true;
+        for(const Dict::Item& item: self._table._items){
+            if(item.first == nullptr) continue;
+            if(!first) ss << ", ";
+            first = false;
+            ss << CAST(Str&, vm->asRepr(item.first));
+        }
+        ss << "}";
+        if(frozen) ss << ")";
+        return VAR(ss.str());
+    });
+
+    _vm->_bind_methods<1>(set_types, "__eq__", [](VM* vm, ArgsView args) {
+        const Set& self = _check_set(vm, args[0]);
+        if(!is_set_like(vm, args[1])) return vm->False;
+        const Set& other = OBJ_GET(Set, args[1]);
+        return VAR(self.size() == other.size() && self.issubset(vm, other));
+    });
+
+    _vm->_bind_methods<1>(set_types, "__ne__", [](VM* vm, ArgsView args) {
+        return VAR(!CAST(bool, vm->fast_call(__eq__, two_args(args[0], args[1]))));
+    });
+
+    // operators take sets only, the named methods accept any iterable
+#define BIND_SET_OP(op, iop, method, update)                                               \
+    _vm->_bind_methods<1>(set_types, op, [](VM* vm, ArgsView args) {                        \
+        Set ret = _check_set(vm, args[0]);                                                  \
+        ret.update(vm, _check_set(vm, args[1]));                                            \
+        return vm->new_object(args[0]->type, std::move(ret));                               \
+    });                                                                                     \
+    _vm->_bind_methods<1>(set_types, method, [](VM* vm, ArgsView args) {                    \
+        Set ret = _check_set(vm, args[0]);                                                  \
+        Set tmp;                                                                            \
+        ret.update(vm, _as_set(vm, args[1], tmp));                                          \
+        return vm->new_object(args[0]->type, std::move(ret));                               \
+    });                                                                                     \
+    _vm->bind_method<1>("set", iop, [](VM* vm, ArgsView args) {                             \
+        CAST(Set&, args[0]).update(vm, _check_set(vm, args[1]));                            \
+        return args[0];                                                                     \
+    });                                                                                     \
+    _vm->bind_method<1>("set", #update, [](VM* vm, ArgsView args) {                         \
+        Set tmp;                                                                            \
+        CAST(Set&, args[0]).update(vm, _as_set(vm, args[1], tmp));                          \
+        return vm->None;                                                                    \
+    });
+
+    BIND_SET_OP("__or__", "__ior__", "union", update)
+    BIND_SET_OP("__and__", "__iand__", "intersection", intersection_update)
+    BIND_SET_OP("__sub__", "__isub__", "difference", difference_update)
+    BIND_SET_OP("__xor__", "__ixor__", "symmetric_difference", symmetric_difference_update)
+#undef BIND_SET_OP
+
+    _vm->_bind_methods<1>(set_types, "issubset", [](VM* vm, ArgsView args) {
+        Set tmp;
+        return VAR(_check_set(vm, args[0]).issubset(vm, _as_set(vm, args[1], tmp)));
+    });
+
+    _vm->_bind_methods<1>(set_types, "issuperset", [](VM* vm, ArgsView args) {
+        Set tmp;
+        return VAR(_as_set(vm, args[1], tmp).issubset(vm, _check_set(vm, args[0])));
+    });
+
+    _vm->_bind_methods<1>(set_types, "isdisjoint", [](VM* vm, ArgsView args) {
+        Set tmp;
+        return VAR(_check_set(vm, args[0]).isdisjoint(vm, _as_set(vm, args[1], tmp)));
+    });
+
+    _vm->bind_method<1>("set", "add", [](VM* vm, ArgsView args) {
+        CAST(Set&, args[0]).add(vm, args[1]);
+        return vm->None;
+    });
+
+    _vm->bind_method<1>("set", "remove", [](VM* vm, ArgsView args) {
+        bool ok = CAST(Set&, args[0]).discard(vm, args[1]);
+        if(!ok) vm->_error("KeyError", CAST(Str, vm->asRepr(args[1])));
+        return vm->None;
+    });
+
+    _vm->bind_method<1>("set", "discard", [](VM* vm, ArgsView args) {
+        CAST(Set&, args[0]).discard(vm, args[1]);
+        return vm->None;
+    });
+
+    _vm->bind_method<0>("set", "clear", [](VM* vm, ArgsView args) {
+        CAST(Set&, args[0]).clear();
+        return vm->None;
+    });
+
     /************ PyBool ************/
     _vm->bind_static_method<1>("bool", "__new__", CPP_LAMBDA(vm->asBool(args[0])));
 
-    _vm->bind_method<0>("bool", "__repr__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("bool", "__repr__", [](VM* vm, ArgsView args) {
         bool val = CAST(bool, args[0]);
         return VAR(val ? "True" : "False");
     });
 
-    _vm->bind_method<0>("bool", "__json__", [](VM* vm, Args& args) {
+    _vm->bind_method<0>("bool", "__json__", [](VM* vm, ArgsView args) {
         bool val = CAST(bool, args[0]);
         return VAR(val ? "true" : "false");
     });
 
-    _vm->bind_method<1>("bool", "__xor__", [](VM* vm, Args& args) {
+    _vm->bind_method<1>("bool", "__xor__", [](VM* vm, ArgsView args) {
         bool self = CAST(bool, args[0]);
         bool other = CAST(bool, args[1]);
         return VAR(self ^ other);
@@ -576,7 +1321,7 @@ void init_builtins(VM* _vm) {
 
 void add_module_time(VM* vm){
     PyVar mod = vm->new_module("time");
-    vm->bind_func<0>(mod, "time", [](VM* vm, Args& args) {
+    vm->bind_func<0>(mod, "time", [](VM* vm, ArgsView args) {
         auto now = std::chrono::high_resolution_clock::now();
         return VAR(std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count() / 1000000.0);
     });
@@ -587,17 +1332,91 @@ void add_module_sys(VM* vm){
     vm->setattr(mod, "version", VAR(PK_VERSION));
 
     vm->bind_func<1>(mod, "getrefcount", CPP_LAMBDA(VAR(args[0].use_count())));
+
+    // the block of the object and its attribute table, not the memory its payload points to
+    vm->bind_func<1>(mod, "getsizeof", [](VM* vm, ArgsView args) {
+        const PyVar& obj = args[0];
+        if(obj.is_tagged()) return VAR((i64)sizeof(PyVar));
+        i64 size = MemoryPool::block_size(_py_kinds[obj->_kind].size);
+        if(obj->is_attr_valid()) size += sizeof(NameDict) + obj->attr()._capacity * kNameDictNodeSize;
+        if(obj->has_shape()){
+            const DummyInstance& inst = OBJ_GET(DummyInstance, obj);
+            if(inst.is_dict_mode()) size += sizeof(NameDict) + inst._dict->_capacity * kNameDictNodeSize;
+            else size += inst._overflow_capacity * sizeof(PyVar);
+        }
+        return VAR(size);
+    });
     vm->bind_func<0>(mod, "getrecursionlimit", CPP_LAMBDA(VAR(vm->recursionlimit)));
 
-    vm->bind_func<1>(mod, "setrecursionlimit", [](VM* vm, Args& args) {
+    vm->bind_func<1>(mod, "setrecursionlimit", [](VM* vm, ArgsView args) {
         vm->recursionlimit = CAST(int, args[0]);
         return vm->None;
     });
+
+    vm->bind_func<0>(mod, "gettracebacklimit", CPP_LAMBDA(VAR(vm->tracebacklimit)));
+
+    vm->bind_func<1>(mod, "settracebacklimit", [](VM* vm, ArgsView args) {
+        vm->tracebacklimit = CAST(int, args[0]);
+        return vm->None;
+    });
+}
+
+void add_module_gc(VM* vm){
+    PyVar mod = vm->new_module("gc");
+    vm->bind_func<0>(mod, "collect", [](VM* vm, ArgsView args) {
+        int gen = CAST(int, args[0]);
+        if(gen < 0 || gen >= CycleCollector::kNumGenerations) vm->ValueError("invalid generation");
+        return VAR(vm->_gc.collect(gen));
+    }, {{"generation", VAR(CycleCollector::kNumGenerations - 1)}});
+
+    vm->bind_func<0>(mod, "enable", [](VM* vm, ArgsView args) {
+        vm->_gc.enabled = true;
+        return vm->None;
+    });
+    vm->bind_func<0>(mod, "disable", [](VM* vm, ArgsView args) {
+        vm->_gc.enabled = false;
+        vm->_gc._pending = false;
+        return vm->None;
+    });
+    vm->bind_func<0>(mod, "isenabled", CPP_LAMBDA(VAR(vm->_gc.enabled)));
+
+    vm->bind_func<0>(mod, "get_threshold", [](VM* vm, ArgsView args) {
+        Tuple t(CycleCollector::kNumGenerations);
+        for(int i=0; i<t.size(); i++) t[i] = VAR(vm->_gc.thresholds[i]);
+        return VAR(std::move(t));
+    });
+    // a threshold of 0 turns collection off
+    vm->bind_func<-1>(mod, "set_threshold", [](VM* vm, ArgsView args) {
+        if(args.size() < 1 || args.size() > CycleCollector::kNumGenerations){
+            vm->TypeError("set_threshold() takes 1 to 3 arguments");
+        }
+        for(int i=0; i<args.size(); i++) vm->_gc.thresholds[i] = CAST(int, args[i]);
+        return vm->None;
+    });
+
+    vm->bind_func<0>(mod, "get_count", [](VM* vm, ArgsView args) {
+        Tuple t(CycleCollector::kNumGenerations);
+        for(int i=0; i<t.size(); i++) t[i] = VAR(vm->_gc.counts[i]);
+        return VAR(std::move(t));
+    });
+
+    // one dict per generation, as in CPython; nothing is ever uncollectable here
+    vm->bind_func<0>(mod, "get_stats", [](VM* vm, ArgsView args) {
+        List ret;
+        for(const CycleCollector::Stats& s: vm->_gc.stats){
+            Dict d;
+            d.set(vm, VAR("collections"), VAR(s.collections));
+            d.set(vm, VAR("collected"), VAR(s.collected));
+            d.set(vm, VAR("uncollectable"), VAR(0));
+            ret.push_back(VAR(std::move(d)));
+        }
+        return VAR(std::move(ret));
+    });
 }
 
 void add_module_json(VM* vm){
     PyVar mod = vm->new_module("json");
-    vm->bind_func<1>(mod, "loads", [](VM* vm, Args& args) {
+    vm->bind_func<1>(mod, "loads", [](VM* vm, ArgsView args) {
         const Str& expr = CAST(Str&, args[0]);
         CodeObject_ code = vm->compile(expr, "<json>", JSON_MODE);
         return vm->_exec(code, vm->top_frame()->_module, vm->top_frame()->_locals);
@@ -627,7 +1446,7 @@ void add_module_math(VM* vm){
 
 void add_module_dis(VM* vm){
     PyVar mod = vm->new_module("dis");
-    vm->bind_func<1>(mod, "dis", [](VM* vm, Args& args) {
+    vm->bind_func<1>(mod, "dis", [](VM* vm, ArgsView args) {
         PyVar f = args[0];
         if(is_type(f, vm->tp_bound_method)) f = CAST(BoundMethod, args[0]).method;
         CodeObject_ code = CAST(Function, f).code;
@@ -649,12 +1468,12 @@ struct ReMatch {
         vm->bind_method<0>(type, "start", CPP_LAMBDA(VAR(CAST(ReMatch&, args[0]).start)));
         vm->bind_method<0>(type, "end", CPP_LAMBDA(VAR(CAST(ReMatch&, args[0]).end)));
 
-        vm->bind_method<0>(type, "span", [](VM* vm, Args& args) {
+        vm->bind_method<0>(type, "span", [](VM* vm, ArgsView args) {
             auto& self = CAST(ReMatch&, args[0]);
             return VAR(two_args(VAR(self.start), VAR(self.end)));
         });
 
-        vm->bind_method<1>(type, "group", [](VM* vm, Args& args) {
+        vm->bind_method<1>(type, "group", [](VM* vm, ArgsView args) {
             auto& self = CAST(ReMatch&, args[0]);
             int index = CAST(int, args[1]);
             index = vm->normalized_index(index, self.m.size());
@@ -679,19 +1498,19 @@ void add_module_re(VM* vm){
     PyVar mod = vm->new_module("re");
     ReMatch::register_class(vm, mod);
 
-    vm->bind_func<2>(mod, "match", [](VM* vm, Args& args) {
+    vm->bind_func<2>(mod, "match", [](VM* vm, ArgsView args) {
         const Str& pattern = CAST(Str&, args[0]);
         const Str& string = CAST(Str&, args[1]);
         return _regex_search(pattern, string, true, vm);
     });
 
-    vm->bind_func<2>(mod, "search", [](VM* vm, Args& args) {
+    vm->bind_func<2>(mod, "search", [](VM* vm, ArgsView args) {
         const Str& pattern = CAST(Str&, args[0]);
         const Str& string = CAST(Str&, args[1]);
         return _regex_search(pattern, string, false, vm);
     });
 
-    vm->bind_func<3>(mod, "sub", [](VM* vm, Args& args) {
+    vm->bind_func<3>(mod, "sub", [](VM* vm, ArgsView args) {
         const Str& pattern = CAST(Str&, args[0]);
         const Str& repl = CAST(Str&, args[1]);
         const Str& string = CAST(Str&, args[2]);
@@ -699,7 +1518,7 @@ void add_module_re(VM* vm){
         return VAR(std::regex_replace(string, re, repl));
     });
 
-    vm->bind_func<2>(mod, "split", [](VM* vm, Args& args) {
+    vm->bind_func<2>(mod, "split", [](VM* vm, ArgsView args) {
         const Str& pattern = CAST(Str&, args[0]);
         const Str& string = CAST(Str&, args[1]);
         std::regex re(pattern);
@@ -759,6 +1578,7 @@ void add_module_random(VM* vm){
 void VM::post_init(){
     init_builtins(this);
     add_module_sys(this);
+    add_module_gc(this);
     add_module_time(this);
     add_module_json(this);
     add_module_math(this);
@@ -775,18 +1595,14 @@ void VM::post_init(){
 
     CodeObject_ code = compile(kPythonLibs["builtins"], "<builtins>", EXEC_MODE);
     this->_exec(code, this->builtins);
-    code = compile(kPythonLibs["dict"], "<builtins>", EXEC_MODE);
-    this->_exec(code, this->builtins);
-    code = compile(kPythonLibs["set"], "<builtins>", EXEC_MODE);
-    this->_exec(code, this->builtins);
 
     // property is defined in builtins.py so we need to add it after builtins is loaded
     _t(tp_object)->attr().set(__class__, property(CPP_LAMBDA(vm->_t(args[0]))));
-    _t(tp_type)->attr().set(__base__, property([](VM* vm, Args& args){
+    _t(tp_type)->attr().set(__base__, property([](VM* vm, ArgsView args){
         const PyTypeInfo& info = vm->_all_types[OBJ_GET(Type, args[0]).index];
         return info.base.index == -1 ? vm->None : vm->_all_types[info.base.index].obj;
     }));
-    _t(tp_type)->attr().set(__name__, property([](VM* vm, Args& args){
+    _t(tp_type)->attr().set(__name__, property([](VM* vm, ArgsView args){
         const PyTypeInfo& info = vm->_all_types[OBJ_GET(Type, args[0]).index];
         return VAR(info.name);
     }));
@@ -951,7 +1767,7 @@ extern "C" {
         for(int i=0; name[i]; i++) if(name[i] == ' ') return nullptr;
         std::string f_header = std::string(mod) + '.' + name + '#' + std::to_string(kGlobalBindId++);
         pkpy::PyVar obj = vm->_modules.contains(mod) ? vm->_modules[mod] : vm->new_module(mod);
-        vm->bind_func<-1>(obj, name, [ret_code, f_header](pkpy::VM* vm, const pkpy::Args& args){
+        vm->bind_func<-1>(obj, name, [ret_code, f_header](pkpy::VM* vm, pkpy::ArgsView args){
             pkpy::StrStream ss;
             ss << f_header;
             for(int i=0; i<args.size(); i++){
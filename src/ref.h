@@ -19,8 +19,15 @@ struct NameRef : BaseRef {
     NameRef(const std::pair<StrName, NameScope>& pair) : pair(pair) {}
 
     PyVar get(VM* vm, Frame* frame) const{
+        int i = frame->f_fast_index(name());
+        if(i >= 0 && frame->_fast_locals[i] != nullptr) return frame->_fast_locals[i];
+        return get_from_dicts(vm, frame);
+    }
+
+    // skips fast locals, for names known to have no slot (LOAD_NAME in a fast frame)
+    PyVar get_from_dicts(VM* vm, Frame* frame) const{
         PyVar* val;
-        val = frame->f_locals().try_get(name());
+        val = frame->f_locals_try_get(name());
         if(val != nullptr) return *val;
         val = frame->f_closure_try_get(name());
         if(val != nullptr) return *val;
@@ -34,7 +41,11 @@ struct NameRef : BaseRef {
 
     void set(VM* vm, Frame* frame, PyVar val) const{
         switch(scope()) {
-            case NAME_LOCAL: frame->f_locals().set(name(), std::move(val)); break;
+            case NAME_LOCAL: {
+                int i = frame->f_fast_index(name());
+                if(i >= 0) frame->_fast_locals[i] = std::move(val);
+                else frame->f_locals().set(name(), std::move(val));
+            } break;
             case NAME_GLOBAL:
                 if(frame->f_locals().try_set(name(), std::move(val))) return;
                 frame->f_globals().set(name(), std::move(val));
@@ -43,10 +54,27 @@ struct NameRef : BaseRef {
         }
     }
 
+    // the variable set() would overwrite, nullptr if it is not bound yet
+    PyVar* try_get_slot(Frame* frame) const{
+        if(scope() == NAME_LOCAL){
+            int i = frame->f_fast_index(name());
+            if(i >= 0) return &frame->_fast_locals[i];
+            return frame->f_locals().try_get(name());
+        }
+        PyVar* val = frame->f_locals().try_get(name());
+        if(val != nullptr) return val;
+        return frame->f_globals().try_get(name());
+    }
+
     void del(VM* vm, Frame* frame) const{
         switch(scope()) {
             case NAME_LOCAL: {
-                if(frame->f_locals().contains(name())){
+                int i = frame->f_fast_index(name());
+                if(i >= 0){
+                    if(frame->_fast_locals[i] == nullptr) vm->NameError(name());
+                    frame->_fast_locals[i].reset();
+                    if(frame->_locals != nullptr && frame->_locals->contains(name())) frame->_locals->erase(name());
+                }else if(frame->f_locals().contains(name())){
                     frame->f_locals().erase(name());
                 }else{
                     vm->NameError(name());
@@ -83,9 +111,7 @@ struct AttrRef : BaseRef {
     }
 
     void del(VM* vm, Frame* frame) const{
-        if(!obj->is_attr_valid()) vm->TypeError("cannot delete attribute");
-        if(!obj->attr().contains(attr.name())) vm->AttributeError(obj, attr.name());
-        obj->attr().erase(attr.name());
+        vm->delattr(obj, attr.name());
     }
 };
 
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "common.h"
+#include "str.h"
+
+namespace pkpy{
+
+// the attribute layout shared by the instances that were given the same attributes in the
+// same order, after V8's hidden classes: a shape maps names to slot indices, and adding an
+// attribute moves an instance to a child shape. Shapes are never changed or freed while
+// their VM lives, so a (shape id, slot) pair found once stays valid for inline caches.
+struct Shape {
+    uint32_t id;
+    int size;           // number of slots
+    // names[i] is the name of slot i; a shape extends the array of its parent when it can
+    std::shared_ptr<std::vector<StrName>> names;
+    std::map<StrName, uint32_t> transitions;    // child shapes by added name
+
+    int index_of(StrName name) const {
+        const StrName* p = names->data();
+        for(int i=0; i<size; i++) if(p[i] == name) return i;
+        return -1;
+    }
+};
+
+const uint32_t kNoShape = 0xffffffff;
+// the shape of an instance in dictionary mode, its attributes are in a NameDict
+const uint32_t kDictShape = 0xfffffffe;
+
+// the shapes of a VM, indexed by id; the empty shape has id 0. Wide instances and instances
+// that lost an attribute go to dictionary mode instead of growing the tree, as in V8, and
+// the tree itself is capped so that programs making up names cannot grow it without bound
+struct ShapeTable {
+    static const uint32_t kEmpty = 0;
+    static const int kMaxSlots = 32;
+    static const int kMaxShapes = 8192;
+    std::vector<std::unique_ptr<Shape>> _shapes;
+
+    ShapeTable(){
+        _shapes.push_back(std::unique_ptr<Shape>(new Shape{kEmpty, 0, std::make_shared<std::vector<StrName>>()}));
+    }
+
+    inline const Shape& operator[](uint32_t id) const { return *_shapes[id]; }
+
+    // the shape of `from` with `name` appended, or kDictShape if that would pass a limit
+    uint32_t add_name(uint32_t from, StrName name){
+        Shape& parent = *_shapes[from];
+        auto it = parent.transitions.find(name);
+        if(it != parent.transitions.end()) return it->second;
+        if(parent.size >= kMaxSlots || _shapes.size() >= kMaxShapes) return kDictShape;
+        std::shared_ptr<std::vector<StrName>> names = parent.names;
+        if(names->size() != parent.size){
+            // another child extended the array already
+            names = std::make_shared<std::vector<StrName>>(names->begin(), names->begin() + parent.size);
+        }
+        names->push_back(name);
+        uint32_t id = _shapes.size();
+        _shapes.push_back(std::unique_ptr<Shape>(new Shape{id, parent.size + 1, names}));
+        parent.transitions.emplace(name, id);
+        return id;
+    }
+};
+
+} // namespace pkpy
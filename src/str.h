@@ -1,23 +1,337 @@
 #pragma once
 
 #include "common.h"
+#include "unicode.h"
 
 namespace pkpy {
 
 typedef std::stringstream StrStream;
 
+/* byte scanning behind the str methods, 16 bytes at a time when SSE2 is available */
+#if PK_ENABLE_SSE2
+inline int _ctz(unsigned int x){
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return (int)i;
+#else
+    return __builtin_ctz(x);
+#endif
+}
+
+inline int _popcount(unsigned int x){
+#ifdef _MSC_VER
+    return (int)__popcnt(x);
+#else
+    return __builtin_popcount(x);
+#endif
+}
+
+// 0xFF in the lanes holding ' ', '\t', '\n', '\v', '\f' or '\r'
+inline __m128i _sse2_isspace(__m128i v){
+    __m128i t = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+    __m128i ctrl = _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(4)), t);
+    return _mm_or_si128(ctrl, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+}
+#endif
+
+inline bool is_space_char(char c){
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool is_ascii(const char* p, size_t n){
+    size_t i = 0;
+#if PK_ENABLE_SSE2
+    __m128i acc = _mm_setzero_si128();
+    for(; i + 16 <= n; i += 16) acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i*)(p + i)));
+    if(_mm_movemask_epi8(acc) != 0) return false;
+#endif
+    for(; i < n; i++) if((unsigned char)p[i] >= 0x80) return false;
+    return true;
+}
+
+// the number of code points in [p, p+n), i.e. the bytes that are not 10xxxxxx
+inline size_t utf8_count(const char* p, size_t n){
+    size_t i = 0, cont = 0;
+#if PK_ENABLE_SSE2
+    const __m128i limit = _mm_set1_epi8(-64);
+    for(; i + 16 <= n; i += 16){
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        cont += _popcount(_mm_movemask_epi8(_mm_cmplt_epi8(v, limit)));
+    }
+#endif
+    for(; i < n; i++) if((p[i] & 0xC0) == 0x80) cont++;
+    return n - cont;
+}
+
+// the byte offset of code point `k` in [p, p+n), or n if there are fewer
+inline size_t utf8_advance(const char* p, size_t n, size_t k){
+    size_t i = 0;
+#if PK_ENABLE_SSE2
+    // skip whole blocks while they hold fewer than k code point starts
+    const __m128i limit = _mm_set1_epi8(-64);
+    for(; i + 16 <= n; i += 16){
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        size_t starts = 16 - _popcount(_mm_movemask_epi8(_mm_cmplt_epi8(v, limit)));
+        if(starts > k) break;
+        k -= starts;
+    }
+#endif
+    for(; i < n; i++){
+        if((p[i] & 0xC0) == 0x80) continue;
+        if(k == 0) return i;
+        k--;
+    }
+    return n;
+}
+
+// the first whitespace byte in [p, end), or end
+inline const char* find_space(const char* p, const char* end){
+#if PK_ENABLE_SSE2
+    for(; p + 16 <= end; p += 16){
+        int mask = _mm_movemask_epi8(_sse2_isspace(_mm_loadu_si128((const __m128i*)p)));
+        if(mask != 0) return p + _ctz(mask);
+    }
+#endif
+    while(p < end && !is_space_char(*p)) p++;
+    return p;
+}
+
+// the first non-whitespace byte in [p, end), or end
+inline const char* skip_space(const char* p, const char* end){
+#if PK_ENABLE_SSE2
+    for(; p + 16 <= end; p += 16){
+        int mask = _mm_movemask_epi8(_sse2_isspace(_mm_loadu_si128((const __m128i*)p))) ^ 0xFFFF;
+        if(mask != 0) return p + _ctz(mask);
+    }
+#endif
+    while(p < end && is_space_char(*p)) p++;
+    return p;
+}
+
+// the first position >= from of `sub` in `s`, or std::string::npos;
+// candidates must match the first and the last byte of `sub` before they are compared
+inline size_t str_find(const char* s, size_t n, const char* sub, size_t m, size_t from=0){
+    if(from > n || m > n - from) return std::string::npos;
+    if(m == 0) return from;
+    if(m == 1){
+        const void* r = std::memchr(s + from, sub[0], n - from);
+        return r == nullptr ? std::string::npos : (const char*)r - s;
+    }
+    size_t i = from;
+#if PK_ENABLE_SSE2
+    const __m128i first = _mm_set1_epi8(sub[0]);
+    const __m128i last = _mm_set1_epi8(sub[m-1]);
+    for(; i + m - 1 + 16 <= n; i += 16){
+        __m128i bf = _mm_loadu_si128((const __m128i*)(s + i));
+        __m128i bl = _mm_loadu_si128((const __m128i*)(s + i + m - 1));
+        int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(bf, first), _mm_cmpeq_epi8(bl, last)));
+        while(mask != 0){
+            int j = _ctz(mask);
+            if(std::memcmp(s + i + j + 1, sub + 1, m - 2) == 0) return i + j;
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for(; i + m <= n; i++){
+        if(s[i] == sub[0] && std::memcmp(s + i, sub, m) == 0) return i;
+    }
+    return std::string::npos;
+}
+
+// the byte length of the code point starting with `c`, stray continuation bytes count as 1
+inline int utf8_lead_len(unsigned char c){
+    if(c < 0xC0) return 1;
+    if(c < 0xE0) return 2;
+    if(c < 0xF0) return 3;
+    return 4;
+}
+
+// maps 'a'-'z' to 'A'-'Z' (upper) or back; UTF-8 sequences never contain ASCII bytes.
+// Returns false if `p` has non-ASCII bytes, which need unicode_case()
+inline bool ascii_case(char* p, size_t n, bool upper){
+    char lo = upper ? 'a' : 'A';
+    char hi = upper ? 'z' : 'Z';
+    size_t i = 0;
+    unsigned char high = 0;
+#if PK_ENABLE_SSE2
+    const __m128i vlo = _mm_set1_epi8(lo - 1);
+    const __m128i vhi = _mm_set1_epi8(hi + 1);
+    const __m128i flip = _mm_set1_epi8(0x20);
+    __m128i acc = _mm_setzero_si128();
+    for(; i + 16 <= n; i += 16){
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        acc = _mm_or_si128(acc, v);
+        __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(v, vlo), _mm_cmplt_epi8(v, vhi));
+        _mm_storeu_si128((__m128i*)(p + i), _mm_xor_si128(v, _mm_and_si128(in_range, flip)));
+    }
+    if(_mm_movemask_epi8(acc) != 0) high = 0x80;
+#endif
+    for(; i < n; i++){
+        high |= (unsigned char)p[i];
+        if(p[i] >= lo && p[i] <= hi) p[i] ^= 0x20;
+    }
+    return high < 0x80;
+}
+
+// the code point starting at `p`, `n` > 0 bytes long at most; a truncated or stray byte decodes as itself
+inline uint32_t utf8_decode(const char* p, size_t n, int* len){
+    unsigned char c = p[0];
+    *len = utf8_lead_len(c);
+    if(*len == 1 || (size_t)*len > n){
+        *len = 1;
+        return c;
+    }
+    uint32_t cp = c & (0x7F >> *len);
+    for(int i=1; i<*len; i++) cp = (cp << 6) | (p[i] & 0x3F);
+    return cp;
+}
+
+inline void utf8_encode(uint32_t cp, std::string& out){
+    if(cp < 0x80){
+        out.push_back((char)cp);
+    }else if(cp < 0x800){
+        out.push_back((char)(0xC0 | (cp >> 6)));
+        out.push_back((char)(0x80 | (cp & 0x3F)));
+    }else if(cp < 0x10000){
+        out.push_back((char)(0xE0 | (cp >> 12)));
+        out.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back((char)(0x80 | (cp & 0x3F)));
+    }else{
+        out.push_back((char)(0xF0 | (cp >> 18)));
+        out.push_back((char)(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back((char)(0x80 | (cp & 0x3F)));
+    }
+}
+
+// the last entry of a table sorted by `first` whose range holds `cp`, or nullptr
+template<typename T, size_t N>
+const T* _unicode_range(const T (&table)[N], uint32_t cp){
+    const T* it = std::upper_bound(table, table + N, cp, [](uint32_t x, const T& r){ return x < r.first; });
+    if(it == table || cp > it[-1].last) return nullptr;
+    return it - 1;
+}
+
+template<size_t N>
+const char* _unicode_special(const UnicodeCaseSpecial (&table)[N], uint32_t cp){
+    const UnicodeCaseSpecial* it = std::lower_bound(table, table + N, cp, [](const UnicodeCaseSpecial& s, uint32_t x){ return s.cp < x; });
+    return (it != table + N && it->cp == cp) ? it->mapped : nullptr;
+}
+
+inline uint32_t _unicode_sigma_kind(uint32_t cp){
+    const UnicodeKindRange* r = _unicode_range(kUnicodeSigmaKind, cp);
+    return r == nullptr ? 0 : r->kind;
+}
+
+// whether the capital sigma at `p + i` ends a word, Unicode's Final_Sigma context:
+// a cased code point before it and none after it, skipping case-ignorable ones
+inline bool _unicode_final_sigma(const char* p, size_t n, size_t i){
+    size_t j = i;
+    uint32_t kind = 1;
+    int len;
+    while(j > 0 && kind == 1){
+        do{ j--; }while(j > 0 && ((unsigned char)p[j] & 0xC0) == 0x80);
+        kind = _unicode_sigma_kind(utf8_decode(p + j, n - j, &len));
+    }
+    if(kind != 2) return false;
+    j = i + 2;      // U+03A3 is 2 bytes long
+    while(j < n){
+        kind = _unicode_sigma_kind(utf8_decode(p + j, n - j, &len));
+        if(kind != 1) return kind != 2;
+        j += len;
+    }
+    return true;
+}
+
+// str.upper and str.lower, including CPython's one-to-many mappings and its final sigma rule
+inline std::string unicode_case(const char* p, size_t n, bool upper){
+    std::string out;
+    out.reserve(n);
+    size_t i = 0;
+    while(i < n){
+        if((unsigned char)p[i] < 0x80){
+            char c = p[i++];
+            if(upper ? (c >= 'a' && c <= 'z') : (c >= 'A' && c <= 'Z')) c ^= 0x20;
+            out.push_back(c);
+            continue;
+        }
+        int len;
+        uint32_t cp = utf8_decode(p + i, n - i, &len);
+        if(len == 1 && cp >= 0x80){
+            out.push_back(p[i++]);      // not UTF-8, kept as it is
+            continue;
+        }
+        const char* special = upper ? _unicode_special(kUnicodeUpperSpecial, cp) : _unicode_special(kUnicodeLowerSpecial, cp);
+        if(special != nullptr){
+            out += special;
+        }else if(!upper && cp == 0x3A3){
+            utf8_encode(_unicode_final_sigma(p, n, i) ? 0x3C2 : 0x3C3, out);
+        }else{
+            const UnicodeCaseRange* r = upper ? _unicode_range(kUnicodeUpper, cp) : _unicode_range(kUnicodeLower, cp);
+            if(r != nullptr && (cp - r->first) % r->stride == 0) cp += r->delta;
+            utf8_encode(cp, out);
+        }
+        i += len;
+    }
+    return out;
+}
+
+// the byte offset of every kStride-th code point of a non-ASCII string; other code points
+// are found by scanning forward from the checkpoint before them, or from the last position
+// looked up, so that walking a string in order takes O(1) per step
+struct Utf8Index {
+    static const size_t kStride = 64;
+
+    std::vector<size_t> checkpoints;
+    size_t length;                  // in code points
+    size_t cursor_cp = 0;
+    size_t cursor_byte = 0;
+
+    Utf8Index(const char* p, size_t n){
+        checkpoints.reserve(n / kStride + 1);
+        size_t pos = 0;
+        do{
+            checkpoints.push_back(pos);
+            pos += utf8_advance(p + pos, n - pos, kStride);
+        }while(pos < n);
+        length = (checkpoints.size() - 1) * kStride + utf8_count(p + checkpoints.back(), n - checkpoints.back());
+    }
+
+    // the byte offset of code point `i`, or n if i >= length
+    size_t byte_offset(const char* p, size_t n, size_t i){
+        if(i >= length) return n;
+        size_t base_cp, base_byte;
+        if(i >= cursor_cp && i - cursor_cp < kStride){
+            base_cp = cursor_cp;
+            base_byte = cursor_byte;
+        }else{
+            base_cp = i - i % kStride;
+            base_byte = checkpoints[i / kStride];
+        }
+        cursor_byte = base_byte + utf8_advance(p + base_byte, n - base_byte, i - base_cp);
+        cursor_cp = i;
+        return cursor_byte;
+    }
+
+    // the number of code points before byte offset `b`
+    size_t code_point_index(const char* p, size_t b) const {
+        size_t k = std::upper_bound(checkpoints.begin(), checkpoints.end(), b) - checkpoints.begin() - 1;
+        return k * kStride + utf8_count(p + checkpoints[k], b - checkpoints[k]);
+    }
+};
+
+// the hash and the ASCII flag are computed on first use and travel with copies,
+// so a Str must not be modified once it has been hashed or indexed
 class Str : public std::string {
-    mutable std::vector<uint16_t>* _u8_index = nullptr;
+    mutable Utf8Index* _u8_index = nullptr;     // non-ASCII only
+    mutable size_t _hash = 0;
+    mutable bool _hash_cached = false;
+    mutable int8_t _ascii = -1;     // -1 until computed
 
     void utf8_lazy_init() const{
         if(_u8_index != nullptr) return;
-        _u8_index = new std::vector<uint16_t>();
-        _u8_index->reserve(size());
-        if(size() > 65535) throw std::runtime_error("str has more than 65535 bytes.");
-        for(uint16_t i = 0; i < size(); i++){
-            // https://stackoverflow.com/questions/3911536/utf-8-unicode-whats-with-0xc0-and-0x80
-            if((at(i) & 0xC0) != 0x80) _u8_index->push_back(i);
-        }
+        _u8_index = new Utf8Index(data(), size());
     }
 public:
     uint16_t _cached_sn_index = 0;
@@ -26,27 +340,38 @@ public:
     Str(const char* s) : std::string(s) {}
     Str(const char* s, size_t n) : std::string(s, n) {}
     Str(const std::string& s) : std::string(s) {}
-    Str(const Str& s) : std::string(s) {
-        if(s._u8_index != nullptr){
-            _u8_index = new std::vector<uint16_t>(*s._u8_index);
-        }
-    }
-    Str(Str&& s) : std::string(std::move(s)) {
-        delete _u8_index;
+    // the index is rebuilt on demand rather than copied
+    Str(const Str& s) : std::string(s), _hash(s._hash), _hash_cached(s._hash_cached), _ascii(s._ascii) {}
+    Str(Str&& s) : std::string(std::move(s)), _hash(s._hash), _hash_cached(s._hash_cached), _ascii(s._ascii) {
         _u8_index = s._u8_index;
         s._u8_index = nullptr;
+        s._hash_cached = false;
+        s._ascii = -1;
+    }
+
+    bool is_ascii() const {
+        if(_ascii < 0) _ascii = pkpy::is_ascii(data(), size());
+        return _ascii;
     }
 
+    // byte offset -> code point index
     i64 _to_u8_index(i64 index) const{
+        if(is_ascii()) return index;
         utf8_lazy_init();
-        auto p = std::lower_bound(_u8_index->begin(), _u8_index->end(), index);
-        if(p != _u8_index->end() && *p != index) UNREACHABLE();
-        return p - _u8_index->begin();
+        return _u8_index->code_point_index(data(), index);
+    }
+
+    // code point index -> byte offset, size() if past the end
+    size_t u8_byte_offset(i64 i) const {
+        if(is_ascii()) return std::min<size_t>(i, size());
+        utf8_lazy_init();
+        return _u8_index->byte_offset(data(), size(), i);
     }
 
     int u8_length() const {
+        if(is_ascii()) return size();
         utf8_lazy_init();
-        return _u8_index->size();
+        return _u8_index->length;
     }
 
     Str u8_getitem(int i) const{
@@ -54,14 +379,19 @@ public:
     }
 
     Str u8_substr(int start, int end) const{
-        utf8_lazy_init();
         if(start >= end) return Str();
-        int c_end = end >= _u8_index->size() ? size() : _u8_index->at(end);
-        return substr(_u8_index->at(start), c_end - _u8_index->at(start));
+        if(is_ascii()){
+            if(end > size()) end = size();
+            Str ret(data() + start, end - start);
+            ret._ascii = 1;
+            return ret;
+        }
+        size_t bs = u8_byte_offset(start);
+        return substr(bs, u8_byte_offset(end) - bs);
     }
 
     Str lstrip() const {
-        Str copy(*this);
+        std::string copy(*this);
         copy.erase(copy.begin(), std::find_if(copy.begin(), copy.end(), [](char c) {
             // std::isspace(c) does not working on windows (Debug)
             return c != ' ' && c != '\t' && c != '\r' && c != '\n';
@@ -69,8 +399,22 @@ public:
         return Str(copy);
     }
 
+    // appends in place, only for a Str nothing else can observe (see INPLACE_BINARY_OP)
+    void _inplace_append(const Str& other){
+        append(other);
+        delete _u8_index;
+        _u8_index = nullptr;
+        _hash_cached = false;
+        _cached_sn_index = 0;
+        if(_ascii == 1 && !other.is_ascii()) _ascii = 0;
+    }
+
     size_t hash() const {
-        return std::hash<std::string>()(*this);
+        if(!_hash_cached){
+            _hash = std::hash<std::string>()(*this);
+            _hash_cached = true;
+        }
+        return _hash;
     }
 
     Str escape(bool single_quote) const {
@@ -105,19 +449,27 @@ public:
     }
 
     Str& operator=(const Str& s){
+        if(this == &s) return *this;
         this->std::string::operator=(s);
         delete _u8_index;
-        if(s._u8_index != nullptr){
-            _u8_index = new std::vector<uint16_t>(*s._u8_index);
-        }
+        _u8_index = nullptr;
+        _hash = s._hash;
+        _hash_cached = s._hash_cached;
+        _ascii = s._ascii;
         return *this;
     }
 
     Str& operator=(Str&& s){
+        if(this == &s) return *this;
         this->std::string::operator=(std::move(s));
         delete _u8_index;
-        this->_u8_index = s._u8_index;
+        _u8_index = s._u8_index;
         s._u8_index = nullptr;
+        _hash = s._hash;
+        _hash_cached = s._hash_cached;
+        _ascii = s._ascii;
+        s._hash_cached = false;
+        s._ascii = -1;
         return *this;
     }
 
@@ -206,6 +558,7 @@ const StrName __set__ = StrName::get("__set__");
 const StrName __getattr__ = StrName::get("__getattr__");
 const StrName __setattr__ = StrName::get("__setattr__");
 const StrName __call__ = StrName::get("__call__");
+const StrName __eq__ = StrName::get("__eq__");
 
 const StrName m_eval = StrName::get("eval");
 const StrName m_self = StrName::get("self");
@@ -228,4 +581,16 @@ const StrName BITWISE_SPECIAL_METHODS[] = {
     StrName::get("__and__"), StrName::get("__or__"), StrName::get("__xor__")
 };
 
+// optional in-place forms tried by `a op= b` before the binary methods above
+const StrName BINARY_INPLACE_SPECIAL_METHODS[] = {
+    StrName::get("__iadd__"), StrName::get("__isub__"), StrName::get("__imul__"),
+    StrName::get("__itruediv__"), StrName::get("__ifloordiv__"),
+    StrName::get("__imod__"), StrName::get("__ipow__")
+};
+
+const StrName BITWISE_INPLACE_SPECIAL_METHODS[] = {
+    StrName::get("__ilshift__"), StrName::get("__irshift__"),
+    StrName::get("__iand__"), StrName::get("__ior__"), StrName::get("__ixor__")
+};
+
 } // namespace pkpy
\ No newline at end of file
@@ -0,0 +1,295 @@
+#pragma once
+
+#include "common.h"
+
+namespace pkpy{
+
+// stable merge sort that finds the ordered runs already in the data and merges them
+// with galloping, after CPython's listsort; `less` may throw, leaving `a` permuted
+template<typename T, typename Less>
+class TimSort {
+    static const int kMinGallop = 7;
+
+    struct Run { int base; int len; };
+
+    T* a;
+    int n;
+    Less& less;
+    int min_gallop = kMinGallop;
+    std::vector<T> tmp;
+    std::vector<Run> runs;
+
+    static int compute_minrun(int n){
+        int r = 0;
+        while(n >= 64){ r |= n & 1; n >>= 1; }
+        return n + r;
+    }
+
+    // length of the run starting at lo, a strictly descending run is reversed in place
+    int count_run(int lo, int hi){
+        int i = lo + 1;
+        if(i == hi) return 1;
+        if(less(a[i], a[lo])){
+            while(i + 1 < hi && less(a[i+1], a[i])) i++;
+            std::reverse(a + lo, a + i + 1);
+        }else{
+            while(i + 1 < hi && !less(a[i+1], a[i])) i++;
+        }
+        return i + 1 - lo;
+    }
+
+    // [lo, start) is sorted
+    void binary_insertion(int lo, int hi, int start){
+        for(int i=start; i<hi; i++){
+            T pivot = std::move(a[i]);
+            int l = lo, r = i;
+            while(l < r){
+                int m = (l + r) >> 1;
+                if(less(pivot, a[m])) r = m;
+                else l = m + 1;
+            }
+            std::move_backward(a + l, a + i, a + i + 1);
+            a[l] = std::move(pivot);
+        }
+    }
+
+    // the k where p[k-1] < key <= p[k], searching outwards from p[hint]
+    int gallop_left(const T& key, const T* p, int len, int hint){
+        int last = 0, ofs = 1;
+        if(less(p[hint], key)){
+            int max_ofs = len - hint;
+            while(ofs < max_ofs && less(p[hint+ofs], key)){
+                last = ofs;
+                ofs = (ofs << 1) + 1;
+            }
+            if(ofs > max_ofs) ofs = max_ofs;
+            last += hint;
+            ofs += hint;
+        }else{
+            int max_ofs = hint + 1;
+            while(ofs < max_ofs && !less(p[hint-ofs], key)){
+                last = ofs;
+                ofs = (ofs << 1) + 1;
+            }
+            if(ofs > max_ofs) ofs = max_ofs;
+            int t = last;
+            last = hint - ofs;
+            ofs = hint - t;
+        }
+        last++;
+        while(last < ofs){
+            int m = last + ((ofs - last) >> 1);
+            if(less(p[m], key)) last = m + 1;
+            else ofs = m;
+        }
+        return ofs;
+    }
+
+    // the k where p[k-1] <= key < p[k], searching outwards from p[hint]
+    int gallop_right(const T& key, const T* p, int len, int hint){
+        int last = 0, ofs = 1;
+        if(less(key, p[hint])){
+            int max_ofs = hint + 1;
+            while(ofs < max_ofs && less(key, p[hint-ofs])){
+                last = ofs;
+                ofs = (ofs << 1) + 1;
+            }
+            if(ofs > max_ofs) ofs = max_ofs;
+            int t = last;
+            last = hint - ofs;
+            ofs = hint - t;
+        }else{
+            int max_ofs = len - hint;
+            while(ofs < max_ofs && !less(key, p[hint+ofs])){
+                last = ofs;
+                ofs = (ofs << 1) + 1;
+            }
+            if(ofs > max_ofs) ofs = max_ofs;
+            last += hint;
+            ofs += hint;
+        }
+        last++;
+        while(last < ofs){
+            int m = last + ((ofs - last) >> 1);
+            if(less(key, p[m])) ofs = m;
+            else last = m + 1;
+        }
+        return ofs;
+    }
+
+    // merges a[base1, base1+len1) with the run right after it, len1 <= len2
+    void merge_lo(int base1, int len1, int base2, int len2){
+        tmp.clear();
+        for(int i=0; i<len1; i++) tmp.push_back(std::move(a[base1+i]));
+        int c1 = 0, c2 = base2, dest = base1;
+        int mg = min_gallop;
+        a[dest++] = std::move(a[c2++]);
+        if(--len2 == 0) goto done;
+        if(len1 == 1) goto done;
+        while(true){
+            int count1 = 0, count2 = 0;
+            do{
+                if(less(a[c2], tmp[c1])){
+                    a[dest++] = std::move(a[c2++]);
+                    count2++; count1 = 0;
+                    if(--len2 == 0) goto done;
+                }else{
+                    a[dest++] = std::move(tmp[c1++]);
+                    count1++; count2 = 0;
+                    if(--len1 == 1) goto done;
+                }
+            }while((count1 | count2) < mg);
+            do{
+                count1 = gallop_right(a[c2], tmp.data() + c1, len1, 0);
+                if(count1 != 0){
+                    std::move(tmp.begin() + c1, tmp.begin() + c1 + count1, a + dest);
+                    dest += count1; c1 += count1; len1 -= count1;
+                    if(len1 <= 1) goto done;
+                }
+                a[dest++] = std::move(a[c2++]);
+                if(--len2 == 0) goto done;
+                count2 = gallop_left(tmp[c1], a + c2, len2, 0);
+                if(count2 != 0){
+                    std::move(a + c2, a + c2 + count2, a + dest);
+                    dest += count2; c2 += count2; len2 -= count2;
+                    if(len2 == 0) goto done;
+                }
+                a[dest++] = std::move(tmp[c1++]);
+                if(--len1 == 1) goto done;
+                mg--;
+            }while(count1 >= kMinGallop || count2 >= kMinGallop);
+            if(mg < 0) mg = 0;
+            mg += 2;
+        }
+done:
+        min_gallop = std::max(mg, 1);
+        if(len1 == 1 && len2 > 0){
+            std::move(a + c2, a + c2 + len2, a + dest);
+            a[dest + len2] = std::move(tmp[c1]);
+        }else{
+            // the rest of run 2 is already in place
+            std::move(tmp.begin() + c1, tmp.begin() + c1 + len1, a + dest);
+        }
+    }
+
+    // merges a[base1, base1+len1) with the run right after it, len1 >= len2
+    void merge_hi(int base1, int len1, int base2, int len2){
+        tmp.clear();
+        for(int i=0; i<len2; i++) tmp.push_back(std::move(a[base2+i]));
+        int c1 = base1 + len1 - 1, c2 = len2 - 1, dest = base2 + len2 - 1;
+        int mg = min_gallop;
+        a[dest--] = std::move(a[c1--]);
+        if(--len1 == 0) goto done;
+        if(len2 == 1) goto done;
+        while(true){
+            int count1 = 0, count2 = 0;
+            do{
+                if(less(tmp[c2], a[c1])){
+                    a[dest--] = std::move(a[c1--]);
+                    count1++; count2 = 0;
+                    if(--len1 == 0) goto done;
+                }else{
+                    a[dest--] = std::move(tmp[c2--]);
+                    count2++; count1 = 0;
+                    if(--len2 == 1) goto done;
+                }
+            }while((count1 | count2) < mg);
+            do{
+                count1 = len1 - gallop_right(tmp[c2], a + base1, len1, len1 - 1);
+                if(count1 != 0){
+                    dest -= count1; c1 -= count1; len1 -= count1;
+                    std::move_backward(a + c1 + 1, a + c1 + 1 + count1, a + dest + 1 + count1);
+                    if(len1 == 0) goto done;
+                }
+                a[dest--] = std::move(tmp[c2--]);
+                if(--len2 == 1) goto done;
+                count2 = len2 - gallop_left(a[c1], tmp.data(), len2, len2 - 1);
+                if(count2 != 0){
+                    dest -= count2; c2 -= count2; len2 -= count2;
+                    std::move(tmp.begin() + c2 + 1, tmp.begin() + c2 + 1 + count2, a + dest + 1);
+                    if(len2 <= 1) goto done;
+                }
+                a[dest--] = std::move(a[c1--]);
+                if(--len1 == 0) goto done;
+                mg--;
+            }while(count1 >= kMinGallop || count2 >= kMinGallop);
+            if(mg < 0) mg = 0;
+            mg += 2;
+        }
+done:
+        min_gallop = std::max(mg, 1);
+        if(len2 == 1 && len1 > 0){
+            dest -= len1; c1 -= len1;
+            std::move_backward(a + c1 + 1, a + c1 + 1 + len1, a + dest + 1 + len1);
+            a[dest] = std::move(tmp[c2]);
+        }else{
+            // the rest of run 1 is already in place
+            std::move(tmp.begin(), tmp.begin() + len2, a + dest - (len2 - 1));
+        }
+    }
+
+    void merge_at(int i){
+        int base1 = runs[i].base, len1 = runs[i].len;
+        int base2 = runs[i+1].base, len2 = runs[i+1].len;
+        runs[i].len = len1 + len2;
+        runs.erase(runs.begin() + i + 1);
+        // elements of run 1 before the start of run 2, and of run 2 after the end of run 1, stay put
+        int k = gallop_right(a[base2], a + base1, len1, 0);
+        base1 += k; len1 -= k;
+        if(len1 == 0) return;
+        len2 = gallop_left(a[base1 + len1 - 1], a + base2, len2, len2 - 1);
+        if(len2 == 0) return;
+        if(len1 <= len2) merge_lo(base1, len1, base2, len2);
+        else merge_hi(base1, len1, base2, len2);
+    }
+
+    // keeps the pending run lengths growing faster than the fibonacci numbers
+    void merge_collapse(){
+        while(runs.size() > 1){
+            int i = runs.size() - 2;
+            if((i > 0 && runs[i-1].len <= runs[i].len + runs[i+1].len) ||
+               (i > 1 && runs[i-2].len <= runs[i-1].len + runs[i].len)){
+                if(runs[i-1].len < runs[i+1].len) i--;
+            }else if(runs[i].len > runs[i+1].len){
+                break;
+            }
+            merge_at(i);
+        }
+    }
+
+    void merge_force_collapse(){
+        while(runs.size() > 1){
+            int i = runs.size() - 2;
+            if(i > 0 && runs[i-1].len < runs[i+1].len) i--;
+            merge_at(i);
+        }
+    }
+
+public:
+    TimSort(T* a, int n, Less& less): a(a), n(n), less(less) {}
+
+    void sort(){
+        if(n < 2) return;
+        int minrun = compute_minrun(n);
+        int lo = 0;
+        while(lo < n){
+            int len = count_run(lo, n);
+            if(len < minrun){
+                int force = std::min(n - lo, minrun);
+                binary_insertion(lo, lo + force, lo + len);
+                len = force;
+            }
+            runs.push_back(Run{lo, len});
+            merge_collapse();
+            lo += len;
+        }
+        merge_force_collapse();
+    }
+};
+
+template<typename T, typename Less>
+void timsort(T* a, int n, Less less){
+    TimSort<T, Less>(a, n, less).sort();
+}
+
+} // namespace pkpy
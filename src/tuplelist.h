@@ -78,6 +78,26 @@ namespace pkpy {
         ~Args(){ _pool.dealloc(_args, _size); }
     };
 
+    // non-owning view of call arguments, e.g. a slice of the caller's value stack
+    class ArgsView {
+        const PyVar* _begin;
+        int _size;
+    public:
+        ArgsView(const PyVar* begin, int size) : _begin(begin), _size(size) {}
+        ArgsView(const Args& args) : _begin(args.size()==0 ? nullptr : &args[0]), _size(args.size()) {}
+
+        inline const PyVar& operator[](int i) const { return _begin[i]; }
+        inline int size() const { return _size; }
+        inline const PyVar* begin() const { return _begin; }
+        inline const PyVar* end() const { return _begin + _size; }
+
+        Args to_args() const {
+            Args ret(_size);
+            for(int i=0; i<_size; i++) ret[i] = _begin[i];
+            return ret;
+        }
+    };
+
     static const Args _zero(0);
     inline const Args& no_arg() { return _zero; }
 
@@ -2,9 +2,12 @@
 
 #include "frame.h"
 #include "error.h"
+#include "gc.h"
 
 namespace pkpy{
 
+inline i64 _frozenset_hash(VM* vm, const PyVar& obj);     // dict.h
+
 #define DEF_NATIVE_2(ctype, ptype)                                      \
     template<> ctype py_cast<ctype>(VM* vm, const PyVar& obj) {         \
         vm->check_type(obj, vm->ptype);                                 \
@@ -42,16 +45,33 @@ struct PyTypeInfo{
 class VM {
     VM* vm;     // self reference for simplify code
 public:
+    // members are destroyed in reverse order: the frames of `callstack` clear their windows,
+    // then `_value_stack` is freed, `_gc` detach_all()s the tracked objects and `_immortals`
+    // destroys every immortal object. `_shapes` and `_frame_pool` outlive them, because the
+    // instances and generators owned by immortal modules still reference them.
+    FramePool<> _frame_pool;
+    ShapeTable _shapes;
+    ImmortalObjects _immortals;
+    CycleCollector _gc;
+    ValueStack _value_stack;
     std::stack< std::unique_ptr<Frame> > callstack;
     PyVar _py_op_call;
     PyVar _py_op_yield;
+    PyVar _py_op_raise;     // returned by run_frame() when an exception leaves the frame
     std::vector<PyTypeInfo> _all_types;
 
     PyVar run_frame(Frame* frame);
+    PyVarOrNull _fast_binary_op(int op, const PyVar& lhs, const PyVar& rhs);
+    PyVarOrNull _fast_bitwise_op(int op, const PyVar& lhs, const PyVar& rhs);
+    PyVarOrNull _fast_compare_op(int op, const PyVar& lhs, const PyVar& rhs);
+    Opcode _specialize(Frame* frame, const Bytecode& byte, const PyVar& a, const PyVar& b);
+    PyVar* _inplace_target_slot(Frame* frame);
 
     NameDict _modules;                          // loaded modules
     std::map<StrName, Str> _lazy_modules;       // lazy loaded modules
     PyVar None, True, False, Ellipsis;
+    PyVar _ascii_str_pool[128];                 // shared one-character strings
+    std::map<Str, PyVar> _interned_strs;        // shared identifier-like string constants
 
     bool use_stdio;
     std::ostream* _stdout;
@@ -61,6 +81,7 @@ public:
     PyVar _main;            // __main__ module
 
     int recursionlimit = 1000;
+    int tracebacklimit = 8;     // frames recorded in the traceback of an exception
 
     VM(bool use_stdio){
         this->vm = this;
@@ -74,7 +95,21 @@ public:
         }
 
         init_builtin_types();
-        // for(int i=0; i<128; i++) _ascii_str_pool[i] = new_object(tp_str, std::string(1, (char)i));
+    }
+
+    // `obj` lives as long as the VM and copying it no longer writes to its counter
+    inline void _make_immortal(const PyVar& obj){ _immortals.add(obj); }
+
+    // string literals that look like identifiers are shared and immortal, like CPython's interned strings
+    PyVar _intern(const Str& s){
+        if(s.size() == 1 && (unsigned char)s[0] < 128) return _ascii_str_pool[(unsigned char)s[0]];
+        for(char c: s) if(!isalnum((unsigned char)c) && c != '_') return new_object(tp_str, s);
+        auto it = _interned_strs.find(s);
+        if(it != _interned_strs.end()) return it->second;
+        PyVar obj = new_object(tp_str, s);
+        _make_immortal(obj);
+        _interned_strs.emplace(s, obj);
+        return obj;
     }
 
     PyVar asStr(const PyVar& obj){
@@ -176,12 +211,30 @@ public:
         if(callstack.size() > recursionlimit){
             _error("RecursionError", "maximum recursion depth exceeded");
         }
-        return std::make_unique<Frame>(std::forward<Args>(args)...);
+        return std::unique_ptr<Frame>(new(&_frame_pool) Frame(std::forward<Args>(args)...));
+    }
+
+    // the window of a pushed frame starts right above the values of the caller, the caller
+    // may have placed the first `nargs` locals there already
+    inline void _push_frame(std::unique_ptr<Frame>&& frame, int nargs=0){
+        int seg = 0;
+        PyVar* base = _value_stack._segments[0].begin;
+        if(!callstack.empty()){
+            seg = callstack.top()->_segment;
+            base = callstack.top()->_sp;
+        }
+        PyVar* new_base = _value_stack.place(seg, base, frame->_window_size());
+        if(new_base != base){
+            for(int i=0; i<nargs; i++) new_base[i] = std::move(base[i]);
+        }
+        frame->_segment = seg;
+        frame->_bind_stack(new_base);
+        callstack.push(std::move(frame));
     }
 
     template<typename ...Args>
     inline PyVar _exec(Args&&... args){
-        callstack.push(_new_frame(std::forward<Args>(args)...));
+        _push_frame(_new_frame(std::forward<Args>(args)...));
         return _exec();
     }
 
@@ -199,6 +252,8 @@ public:
             .name = (mod!=nullptr && mod!=builtins) ? Str(OBJ_NAME(mod)+"."+name.str()): name.str()
         };
         if(mod != nullptr) mod->attr().set(name, obj);
+        _make_immortal(obj);
+        _all_types[base.index].obj->attr()._add_subclass(&obj->attr());
         _all_types.push_back(info);
         return obj;
     }
@@ -213,23 +268,30 @@ public:
 #if PK_EXTRA_CHECK
         if(!is_type(type, tp_type)) UNREACHABLE();
 #endif
-        return make_sp<PyObject, Py_<std::decay_t<T>>>(OBJ_GET(Type, type), _value);
+        return _new_object<std::decay_t<T>>(OBJ_GET(Type, type), _value);
     }
     template<typename T>
     inline PyVar new_object(const PyVar& type, T&& _value) {
 #if PK_EXTRA_CHECK
         if(!is_type(type, tp_type)) UNREACHABLE();
 #endif
-        return make_sp<PyObject, Py_<std::decay_t<T>>>(OBJ_GET(Type, type), std::move(_value));
+        return _new_object<std::decay_t<T>>(OBJ_GET(Type, type), std::move(_value));
     }
 
     template<typename T>
     inline PyVar new_object(Type type, const T& _value) {
-        return make_sp<PyObject, Py_<std::decay_t<T>>>(type, _value);
+        return _new_object<std::decay_t<T>>(type, _value);
     }
     template<typename T>
     inline PyVar new_object(Type type, T&& _value) {
-        return make_sp<PyObject, Py_<std::decay_t<T>>>(type, std::move(_value));
+        return _new_object<std::decay_t<T>>(type, std::move(_value));
+    }
+
+    template<typename T, typename U>
+    inline PyVar _new_object(Type type, U&& _value) {
+        PyVar obj = make_sp<PyObject, Py_<T>>(type, std::forward<U>(_value));
+        if constexpr(is_gc_tracked_v<T>) _gc.track(&static_cast<Py_<T>*>(obj.get())->_gc);
+        return obj;
     }
 
     PyVar _find_type(const Str& type){
@@ -247,8 +309,8 @@ public:
     }
 
     template<int ARGC>
-    void bind_method(Str type, Str name, NativeFuncRaw fn) {
-        bind_method<ARGC>(_find_type(type), name, fn);
+    void bind_method(Str type, Str name, NativeFuncRaw fn, NativeKwargs kwargs={}) {
+        bind_method<ARGC>(_find_type(type), name, fn, std::move(kwargs));
     }
 
     template<int ARGC, typename... Args>
@@ -262,8 +324,8 @@ public:
     }
 
     template<int ARGC>
-    void bind_builtin_func(Str name, NativeFuncRaw fn) {
-        bind_func<ARGC>(builtins, name, fn);
+    void bind_builtin_func(Str name, NativeFuncRaw fn, NativeKwargs kwargs={}) {
+        bind_func<ARGC>(builtins, name, fn, std::move(kwargs));
     }
 
     int normalized_index(int index, int size){
@@ -280,6 +342,8 @@ public:
     Type tp_function, tp_native_function, tp_native_iterator, tp_bound_method;
     Type tp_slice, tp_range, tp_module, tp_ref;
     Type tp_super, tp_exception, tp_star_wrapper;
+    Type tp_dict, tp_dict_keys, tp_dict_values, tp_dict_items;
+    Type tp_set, tp_frozenset;
 
     template<typename P>
     inline PyVar PyIter(P&& value) {
@@ -355,19 +419,35 @@ public:
     f64 num_to_float(const PyVar& obj);
     const PyVar& asBool(const PyVar& obj);
     i64 hash(const PyVar& obj);
+    bool py_equals(const PyVar& lhs, const PyVar& rhs);
+    bool py_less(const PyVar& lhs, const PyVar& rhs);
     PyVar asRepr(const PyVar& obj);
     PyVar new_module(StrName name);
     Str disassemble(CodeObject_ co);
     void init_builtin_types();
     PyVar call(const PyVar& _callable, Args args, const Args& kwargs, bool opCall);
+    PyVar vectorcall(const PyVar& callable, PyVar* argv, int argc, bool opCall);
+    void _check_call_args(const Function& fn, int argc, const Args& kwargs);
+    void _bind_args(const Function& fn, PyVar* locals, PyVar* argv, int argc, const Args& kwargs);
+    PyVar _call_function(const Function& fn, PyVar* argv, int argc, const Args& kwargs, bool opCall);
     void unpack_args(Args& args);
     PyVarOrNull getattr(const PyVar* obj, StrName name, bool throw_err=true, bool class_only=false);
+    PyVar getattr(const PyVar& obj, StrName name, InlineCache& c);
+    PyVar get_unbound_method(const PyVar& obj, StrName name, PyVar* self, InlineCache& c);
+    void _update_attr_cache(PyObject* objtype, StrName name, InlineCache& c);
+    PyVar* _own_attr(const PyVar& obj, StrName name);
+    PyVar* _own_attr(const PyVar& obj, StrName name, InlineCache& c);
+    bool _set_own_attr(const PyVar& obj, StrName name, PyVar value, InlineCache* c=nullptr);
+    bool _del_own_attr(const PyVar& obj, StrName name);
+    void delattr(const PyVar& obj, StrName name);
+    std::vector<StrName> _own_attr_names(const PyVar& obj);
+    void setattr(const PyVar& obj, StrName name, PyVar value, InlineCache& c);
     template<typename T>
     void setattr(PyVar* obj, StrName name, T&& value);
     template<int ARGC>
-    void bind_method(PyVar obj, Str funcName, NativeFuncRaw fn);
+    void bind_method(PyVar obj, Str funcName, NativeFuncRaw fn, NativeKwargs kwargs={});
     template<int ARGC>
-    void bind_func(PyVar obj, Str funcName, NativeFuncRaw fn);
+    void bind_func(PyVar obj, Str funcName, NativeFuncRaw fn, NativeKwargs kwargs={});
     void _error(Exception e);
     PyVar _exec();
 
@@ -376,7 +456,8 @@ public:
     const BaseRef* PyRef_AS_C(const PyVar& obj);
 };
 
-PyVar NativeFunc::operator()(VM* vm, Args& args) const{
+PyVar NativeFunc::operator()(VM* vm, ArgsView args) const{
+    if(!kwargs.empty()) return call_kw(vm, args, no_arg());
     int args_size = args.size() - (int)method;  // remove self
     if(argc != -1 && args_size != argc) {
         vm->TypeError("expected " + std::to_string(argc) + " arguments, but got " + std::to_string(args_size));
@@ -391,6 +472,29 @@ void CodeObject::optimize(VM* vm){
     perfect_locals_capacity = find_next_capacity(base_n);
     perfect_hash_seed = find_perfect_hash_seed(perfect_locals_capacity, keys);
 
+    if(use_fast_locals){
+        // every local that may be assigned gets a slot; read-only names still go through LOAD_NAME
+        for(const Bytecode& byte: codes){
+            if(byte.op != OP_STORE_NAME && byte.op != OP_DELETE_NAME && byte.op != OP_LOAD_NAME_REF) continue;
+            if(names[byte.arg].second == NAME_LOCAL) add_varname(names[byte.arg].first);
+        }
+        for(Bytecode& byte: codes){
+            uint8_t fast_op;
+            switch(byte.op){
+                case OP_LOAD_NAME: fast_op = OP_LOAD_FAST; break;
+                case OP_STORE_NAME: fast_op = OP_STORE_FAST; break;
+                case OP_DELETE_NAME: fast_op = OP_DELETE_FAST; break;
+                default: continue;
+            }
+            const auto& p = names[byte.arg];
+            if(p.second != NAME_LOCAL) continue;
+            auto it = varnames_inv.find(p.first);
+            if(it == varnames_inv.end()) continue;
+            byte.op = fast_op;
+            byte.arg = it->second;
+        }
+    }
+
     for(int i=1; i<codes.size(); i++){
         if(codes[i].op == OP_UNARY_NEGATIVE && codes[i-1].op == OP_LOAD_CONST){
             codes[i].op = OP_NO_OP;
@@ -398,24 +502,21 @@ void CodeObject::optimize(VM* vm){
             consts[pos] = vm->num_negated(consts[pos]);
         }
 
-        if(i>=2 && codes[i].op == OP_BUILD_INDEX){
+        if(i>=2 && codes[i].op == OP_BUILD_INDEX && codes[i].arg == 1){
             const Bytecode& a = codes[i-1];
             const Bytecode& x = codes[i-2];
-            if(codes[i].arg == 1){
-                if(a.op == OP_LOAD_NAME && x.op == OP_LOAD_NAME){
-                    codes[i].op = OP_FAST_INDEX;
-                }else continue;
-            }else{
-                if(a.op == OP_LOAD_NAME_REF && x.op == OP_LOAD_NAME_REF){
-                    codes[i].op = OP_FAST_INDEX_REF;
-                }else continue;
-            }
+            if(a.op == OP_LOAD_NAME && x.op == OP_LOAD_NAME){
+                codes[i].op = OP_FAST_INDEX;
+            }else continue;
             codes[i].arg = (a.arg << 16) | x.arg;
             codes[i-1].op = OP_NO_OP;
             codes[i-2].op = OP_NO_OP;
         }
     }
 
+    inline_caches.assign(codes.size(), InlineCache());
+    compute_stack_sizes();
+
     // pre-compute sn in co_consts
     for(int i=0; i<consts.size(); i++){
         if(is_type(consts[i], vm->tp_str)){
@@ -436,6 +537,37 @@ DEF_NATIVE_2(Slice, tp_slice)
 DEF_NATIVE_2(Exception, tp_exception)
 DEF_NATIVE_2(StarWrapper, tp_star_wrapper)
 
+// binds keyword parameters like a Python function does: unless argc is -1,
+// positional arguments beyond argc fill them in order
+PyVar NativeFunc::call_kw(VM* vm, ArgsView args, const Args& kw) const{
+    if(kwargs.empty()){
+        if(kw.size() != 0) vm->TypeError("native_function does not accept keyword arguments");
+        return operator()(vm, args);
+    }
+    int n_pos = args.size();
+    int n_extra = 0;
+    if(argc != -1){
+        int args_size = args.size() - (int)method;  // remove self
+        if(args_size < argc || args_size > argc + (int)kwargs.size()){
+            vm->TypeError("expected " + std::to_string(argc) + " arguments, but got " + std::to_string(args_size));
+        }
+        n_pos = (int)method + argc;
+        n_extra = args_size - argc;
+    }
+    Args full(n_pos + kwargs.size());
+    for(int i=0; i<n_pos; i++) full[i] = args[i];
+    for(int j=0; j<kwargs.size(); j++) full[n_pos+j] = j < n_extra ? args[n_pos+j] : kwargs[j].second;
+    for(int i=0; i<kw.size(); i+=2){
+        StrName key = CAST(Str&, kw[i]);
+        int j = 0;
+        while(j < kwargs.size() && kwargs[j].first != key) j++;
+        if(j == kwargs.size()) vm->TypeError(key.str().escape(true) + " is an invalid keyword argument");
+        if(j < n_extra) vm->TypeError("multiple values for argument " + key.str().escape(true));
+        full[n_pos+j] = kw[i+1];
+    }
+    return f(vm, full);
+}
+
 #define PY_CAST_INT(T) \
 template<> T py_cast<T>(VM* vm, const PyVar& obj){ \
     vm->check_type(obj, vm->tp_int); \
@@ -584,6 +716,7 @@ i64 VM::hash(const PyVar& obj){
         }
         return x;
     }
+    if (is_type(obj, tp_frozenset)) return _frozenset_hash(this, obj);
     if (is_type(obj, tp_type)) return obj.bits;
     if (is_type(obj, tp_bool)) return _CAST(bool, obj) ? 1 : 0;
     if (is_float(obj)){
@@ -594,6 +727,20 @@ i64 VM::hash(const PyVar& obj){
     return 0;
 }
 
+bool VM::py_equals(const PyVar& lhs, const PyVar& rhs){
+    if(lhs == rhs) return true;
+    if(is_both_int(lhs, rhs)) return false;
+    if(is_type(lhs, tp_str) && is_type(rhs, tp_str)) return _CAST(Str&, lhs) == _CAST(Str&, rhs);
+    return asBool(fast_call(__eq__, two_args(lhs, rhs))) == True;
+}
+
+bool VM::py_less(const PyVar& lhs, const PyVar& rhs){
+    if(is_both_int(lhs, rhs)) return _CAST(i64, lhs) < _CAST(i64, rhs);
+    if(is_both_int_or_float(lhs, rhs)) return num_to_float(lhs) < num_to_float(rhs);
+    if(is_type(lhs, tp_str) && is_type(rhs, tp_str)) return _CAST(Str&, lhs) < _CAST(Str&, rhs);
+    return asBool(fast_call(CMP_SPECIAL_METHODS[0], two_args(lhs, rhs))) == True;
+}
+
 PyVar VM::asRepr(const PyVar& obj){
     return call(obj, __repr__);
 }
@@ -601,6 +748,7 @@ PyVar VM::asRepr(const PyVar& obj){
 PyVar VM::new_module(StrName name) {
     PyVar obj = new_object(tp_module, DummyModule());
     obj->attr().set(__name__, VAR(name.str()));
+    _make_immortal(obj);
     _modules.set(name, obj);
     return obj;
 }
@@ -612,6 +760,7 @@ Str VM::disassemble(CodeObject_ co){
             jumpTargets.push_back(byte.arg);
         }
     }
+    for(auto& e : co->exception_table) jumpTargets.push_back(e.target);
     StrStream ss;
     ss << std::string(54, '-') << '\n';
     ss << co->name << ":\n";
@@ -639,10 +788,14 @@ Str VM::disassemble(CodeObject_ co){
         if(byte.op == OP_LOAD_CONST){
             argStr += " (" + CAST(Str, asRepr(co->consts[byte.arg])) + ")";
         }
-        if(byte.op == OP_LOAD_NAME_REF || byte.op == OP_LOAD_NAME || byte.op == OP_RAISE || byte.op == OP_STORE_NAME){
+        if(byte.op == OP_LOAD_NAME_REF || byte.op == OP_LOAD_NAME || byte.op == OP_RAISE || byte.op == OP_STORE_NAME ||
+            byte.op == OP_DELETE_NAME || byte.op == OP_STORE_ATTR || byte.op == OP_DELETE_ATTR || byte.op == OP_LOAD_METHOD){
             argStr += " (" + co->names[byte.arg].first.str().escape(true) + ")";
         }
-        if(byte.op == OP_FAST_INDEX || byte.op == OP_FAST_INDEX_REF){
+        if(byte.op == OP_LOAD_FAST || byte.op == OP_STORE_FAST || byte.op == OP_DELETE_FAST){
+            argStr += " (" + co->varnames[byte.arg].str().escape(true) + ")";
+        }
+        if(byte.op == OP_FAST_INDEX){
             auto& a = co->names[byte.arg & 0xFFFF];
             auto& x = co->names[(byte.arg >> 16) & 0xFFFF];
             argStr += " (" + a.first.str() + '[' + x.first.str() + "])";
@@ -680,6 +833,9 @@ void VM::init_builtin_types(){
     PyVar _tp_type = make_sp<PyObject, Py_<Type>>(Type(1), Type(1));
     _all_types.push_back({.obj = _tp_object, .base = -1, .name = "object"});
     _all_types.push_back({.obj = _tp_type, .base = 0, .name = "type"});
+    _tp_object->attr()._add_subclass(&_tp_type->attr());
+    _make_immortal(_tp_object);
+    _make_immortal(_tp_type);
     tp_object = 0; tp_type = 1;
 
     tp_int = _new_type_object("int");
@@ -702,6 +858,12 @@ void VM::init_builtin_types(){
     tp_bound_method = _new_type_object("bound_method");
     tp_super = _new_type_object("super");
     tp_exception = _new_type_object("Exception");
+    tp_dict = _new_type_object("dict");
+    tp_dict_keys = _new_type_object("dict_keys");
+    tp_dict_values = _new_type_object("dict_values");
+    tp_dict_items = _new_type_object("dict_items");
+    tp_set = _new_type_object("set");
+    tp_frozenset = _new_type_object("frozenset");
 
     this->None = new_object(_new_type_object("NoneType"), DUMMY_VAL);
     this->Ellipsis = new_object(_new_type_object("ellipsis"), DUMMY_VAL);
@@ -709,6 +871,12 @@ void VM::init_builtin_types(){
     this->False = new_object(tp_bool, false);
     this->_py_op_call = new_object(_new_type_object("_py_op_call"), DUMMY_VAL);
     this->_py_op_yield = new_object(_new_type_object("_py_op_yield"), DUMMY_VAL);
+    this->_py_op_raise = new_object(_new_type_object("_py_op_raise"), DUMMY_VAL);
+    for(const PyVar& obj: {None, Ellipsis, True, False, _py_op_call, _py_op_yield, _py_op_raise}) _make_immortal(obj);
+    for(int i=0; i<128; i++){
+        _ascii_str_pool[i] = new_object(tp_str, Str(std::string(1, (char)i)));
+        _make_immortal(_ascii_str_pool[i]);
+    }
     this->builtins = new_module("builtins");
     this->_main = new_module("__main__");
     
@@ -722,6 +890,9 @@ void VM::init_builtin_types(){
     builtins->attr().set("list", _t(tp_list));
     builtins->attr().set("tuple", _t(tp_tuple));
     builtins->attr().set("range", _t(tp_range));
+    builtins->attr().set("dict", _t(tp_dict));
+    builtins->attr().set("set", _t(tp_set));
+    builtins->attr().set("frozenset", _t(tp_frozenset));
 
     post_init();
     for(int i=0; i<_all_types.size(); i++){
@@ -753,64 +924,113 @@ PyVar VM::call(const PyVar& _callable, Args args, const Args& kwargs, bool opCal
     }
     
     if(is_type(*callable, tp_native_function)){
-        const auto& f = OBJ_GET(NativeFunc, *callable);
-        if(kwargs.size() != 0) TypeError("native_function does not accept keyword arguments");
-        return f(this, args);
+        return OBJ_GET(NativeFunc, *callable).call_kw(this, args, kwargs);
     } else if(is_type(*callable, tp_function)){
         const Function& fn = CAST(Function&, *callable);
-        NameDict_ locals = make_sp<NameDict>(
-            fn.code->perfect_locals_capacity,
-            kLocalsLoadFactor,
-            fn.code->perfect_hash_seed
-        );
-
-        int i = 0;
-        for(StrName name : fn.args){
-            if(i < args.size()){
-                locals->set(name, std::move(args[i++]));
-                continue;
-            }
-            TypeError("missing positional argument " + name.str().escape(true));
+        return _call_function(fn, args.size() == 0 ? nullptr : &args[0], args.size(), kwargs, opCall);
+    }
+
+    PyVarOrNull call_f = getattr(_callable, __call__, false, true);
+    if(call_f != nullptr){
+        return call(call_f, std::move(args), kwargs, false);
+    }
+    TypeError(OBJ_NAME(_t(*callable)).escape(true) + " object is not callable");
+    return None;
+}
+
+// raises the TypeError of a call that does not match the signature of fn, before a frame
+// is pushed for it
+void VM::_check_call_args(const Function& fn, int argc, const Args& kwargs){
+    if(argc < fn.args.size()){
+        TypeError("missing positional argument " + fn.args[argc].str().escape(true));
+    }
+    if(fn.starred_arg.empty() && argc > fn.args.size() + fn.kwargs_order.size()){
+        TypeError("too many arguments");
+    }
+    for(int i=0; i<kwargs.size(); i+=2){
+        const Str& key = CAST(Str&, kwargs[i]);
+        auto it = std::find(fn.kwargs_order.begin(), fn.kwargs_order.end(), StrName(key));
+        if(it == fn.kwargs_order.end()){
+            TypeError(key.escape(true) + " is an invalid keyword argument for " + fn.name.str() + "()");
         }
+    }
+}
 
-        locals->update(fn.kwargs);
+// fills locals[0..co->varnames.size()) of a call checked by _check_call_args(), moving the
+// positional arguments out of argv[0..argc); arguments are bound to the first slots, see
+// Compiler::_add_f_varnames()
+void VM::_bind_args(const Function& fn, PyVar* locals, PyVar* argv, int argc, const Args& kwargs){
+    const int kw_base = fn.args.size();
+    int i = 0;
+    for(int j=0; j<fn.args.size(); j++) locals[j] = std::move(argv[i++]);
+
+    for(int j=0; j<fn.kwargs_order.size(); j++){
+        locals[kw_base+j] = fn.kwargs[fn.kwargs_order[j]];
+    }
+
+    if(!fn.starred_arg.empty()){
+        List vargs;        // handle *args
+        while(i < argc) vargs.push_back(std::move(argv[i++]));
+        locals[kw_base+fn.kwargs_order.size()] = VAR(Tuple::from_list(std::move(vargs)));
+    }else{
+        for(int j=0; j<fn.kwargs_order.size() && i<argc; j++){
+            locals[kw_base+j] = std::move(argv[i++]);
+        }
+    }
+
+    for(int i=0; i<kwargs.size(); i+=2){
+        StrName key = CAST(Str&, kwargs[i]);
+        auto it = std::find(fn.kwargs_order.begin(), fn.kwargs_order.end(), key);
+        locals[kw_base + (it - fn.kwargs_order.begin())] = kwargs[i+1];
+    }
+}
 
-        if(!fn.starred_arg.empty()){
-            List vargs;        // handle *args
-            while(i < args.size()) vargs.push_back(std::move(args[i++]));
-            locals->set(fn.starred_arg, VAR(Tuple::from_list(std::move(vargs))));
+// calls a Python function with positional arguments moved out of argv[0..argc); a plain
+// function gets its locals bound in the value stack window of its frame, generators and
+// functions without fast locals get them from a temporary
+PyVar VM::_call_function(const Function& fn, PyVar* argv, int argc, const Args& kwargs, bool opCall){
+    const CodeObject* co = fn.code.get();
+    _check_call_args(fn, argc, kwargs);
+    const PyVar& _module = fn._module != nullptr ? fn._module : top_frame()->_module;
+    if(co->use_fast_locals && !co->is_generator){
+        _push_frame(_new_frame(fn.code, _module, nullptr, fn._closure));
+        _bind_args(fn, top_frame()->_fast_locals, argv, argc, kwargs);
+    }else{
+        Args locals(co->varnames.size());
+        _bind_args(fn, locals.size() == 0 ? nullptr : &locals[0], argv, argc, kwargs);
+        std::unique_ptr<Frame> _frame;
+        if(co->use_fast_locals){
+            _frame = _new_frame(fn.code, _module, std::move(locals), fn._closure);
         }else{
-            for(StrName key : fn.kwargs_order){
-                if(i < args.size()){
-                    locals->set(key, std::move(args[i++]));
-                }else{
-                    break;
-                }
+            NameDict_ locals_dict = make_sp<NameDict>(
+                co->perfect_locals_capacity,
+                kLocalsLoadFactor,
+                co->perfect_hash_seed
+            );
+            for(int j=0; j<locals.size(); j++){
+                if(locals[j] != nullptr) locals_dict->set(co->varnames[j], std::move(locals[j]));
             }
-            if(i < args.size()) TypeError("too many arguments");
+            _frame = _new_frame(fn.code, _module, locals_dict, fn._closure);
         }
-        
-        for(int i=0; i<kwargs.size(); i+=2){
-            const Str& key = CAST(Str&, kwargs[i]);
-            if(!fn.kwargs.contains(key)){
-                TypeError(key.escape(true) + " is an invalid keyword argument for " + fn.name.str() + "()");
-            }
-            locals->set(key, kwargs[i+1]);
-        }
-        const PyVar& _module = fn._module != nullptr ? fn._module : top_frame()->_module;
-        auto _frame = _new_frame(fn.code, _module, locals, fn._closure);
-        if(fn.code->is_generator) return PyIter(Generator(this, std::move(_frame)));
-        callstack.push(std::move(_frame));
-        if(opCall) return _py_op_call;
-        return _exec();
+        if(co->is_generator) return PyIter(Generator(this, std::move(_frame)));
+        _push_frame(std::move(_frame));
     }
+    if(opCall) return _py_op_call;
+    return _exec();
+}
 
-    PyVarOrNull call_f = getattr(_callable, __call__, false, true);
-    if(call_f != nullptr){
-        return call(call_f, std::move(args), kwargs, false);
+// calls with positional arguments taken in place from argv[0..argc), e.g. a slice of the caller's
+// value stack; Python functions move them into their locals and natives get an ArgsView
+PyVar VM::vectorcall(const PyVar& callable, PyVar* argv, int argc, bool opCall){
+    if(is_type(callable, tp_native_function)){
+        return OBJ_GET(NativeFunc, callable)(this, ArgsView(argv, argc));
     }
-    TypeError(OBJ_NAME(_t(*callable)).escape(true) + " object is not callable");
-    return None;
+    if(is_type(callable, tp_function)){
+        return _call_function(OBJ_GET(Function, callable), argv, argc, no_arg(), opCall);
+    }
+    Args args(argc);
+    for(int i=0; i<argc; i++) args[i] = std::move(argv[i]);
+    return call(callable, std::move(args), no_arg(), opCall);
 }
 
 void VM::unpack_args(Args& args){
@@ -846,8 +1066,8 @@ PyVarOrNull VM::getattr(const PyVar* obj, StrName name, bool throw_err, bool cla
         if(descr_get != nullptr) return call(*descr_get, two_args(*cls_var, *obj));
     }
     // handle instance __dict__
-    if(!class_only && !(*obj).is_tagged() && (*obj)->is_attr_valid()){
-        PyVar* val = (*obj)->attr().try_get(name);
+    if(!class_only){
+        PyVar* val = _own_attr(*obj, name);
         if(val != nullptr) return *val;
     }
     if(cls_var != nullptr){
@@ -861,6 +1081,56 @@ PyVarOrNull VM::getattr(const PyVar* obj, StrName name, bool throw_err, bool cla
     return nullptr;
 }
 
+void VM::_update_attr_cache(PyObject* objtype, StrName name, InlineCache& c){
+    PyVar* cls_var = find_name_in_mro(objtype, name);
+    c.key = objtype;
+    c.version = objtype->attr()._version;
+    c.value = cls_var;
+    if(cls_var == nullptr){
+        c.kind = CACHE_ATTR_INSTANCE;
+    }else if(_t(*cls_var)->attr().contains(__get__)){
+        c.kind = CACHE_ATTR_DESCRIPTOR;
+    }else if(is_type(*cls_var, tp_function) || is_type(*cls_var, tp_native_function)){
+        c.kind = CACHE_ATTR_METHOD;
+    }else{
+        c.kind = CACHE_ATTR_CLASS_VAR;
+    }
+}
+
+// same as getattr() but remembers the class-side lookup until the version tag of the type changes
+PyVar VM::getattr(const PyVar& obj, StrName name, InlineCache& c){
+    PyObject* objtype = _t(obj).get();
+    if(c.key != objtype || c.version != objtype->attr()._version){
+        if(is_type(obj, tp_super)) return getattr(&obj, name);
+        _update_attr_cache(objtype, name, c);
+    }
+    if(c.kind == CACHE_ATTR_DESCRIPTOR){
+        PyVar cls_var = *c.value;   // the call may run code that invalidates the cache
+        PyVar descr_get = _t(cls_var)->attr()[__get__];
+        return call(descr_get, two_args(cls_var, obj));
+    }
+    PyVar* val = _own_attr(obj, name, c);
+    if(val != nullptr) return *val;
+    if(c.value == nullptr) AttributeError(obj, name);
+    if(c.kind == CACHE_ATTR_METHOD) return VAR(BoundMethod(obj, *c.value));
+    return *c.value;
+}
+
+// for LOAD_METHOD: a function found on the class is returned unbound with `self` set to obj,
+// anything else is returned as getattr() would with `self` left null
+PyVar VM::get_unbound_method(const PyVar& obj, StrName name, PyVar* self, InlineCache& c){
+    PyObject* objtype = _t(obj).get();
+    if(c.key != objtype || c.version != objtype->attr()._version){
+        if(is_type(obj, tp_super)) return getattr(&obj, name);
+        _update_attr_cache(objtype, name, c);
+    }
+    if(c.kind != CACHE_ATTR_METHOD) return getattr(obj, name, c);
+    PyVar* val = _own_attr(obj, name, c);
+    if(val != nullptr) return *val;
+    *self = obj;
+    return *c.value;
+}
+
 template<typename T>
 void VM::setattr(PyVar* obj, StrName name, T&& value){
     static_assert(std::is_same_v<std::decay_t<T>, PyVar>);
@@ -885,19 +1155,154 @@ void VM::setattr(PyVar* obj, StrName name, T&& value){
         }
     }
     // handle instance __dict__
-    if((*obj).is_tagged() || !(*obj)->is_attr_valid()) TypeError("cannot set attribute");
-    (*obj)->attr().set(name, std::forward<T>(value));
+    if(!_set_own_attr(*obj, name, std::forward<T>(value))) TypeError("cannot set attribute");
+}
+
+PyVar* VM::_own_attr(const PyVar& obj, StrName name){
+    if(obj.is_tagged()) return nullptr;
+    if(obj->has_shape()){
+        DummyInstance& inst = OBJ_GET(DummyInstance, obj);
+        if(inst.is_dict_mode()) return inst._dict->try_get(name);
+        int i = _shapes[inst.shape].index_of(name);
+        return i == -1 ? nullptr : &inst.slot(i);
+    }
+    if(obj->is_attr_valid()) return obj->attr().try_get(name);
+    return nullptr;
+}
+
+// remembers the (shape, slot) of `name`, or that the shape has no such slot
+PyVar* VM::_own_attr(const PyVar& obj, StrName name, InlineCache& c){
+    if(obj.is_tagged()) return nullptr;
+    if(obj->has_shape()){
+        DummyInstance& inst = OBJ_GET(DummyInstance, obj);
+        if(inst.shape != c.shape){
+            if(inst.is_dict_mode()){
+                c.shape = kNoShape;
+                return inst._dict->try_get_hinted(name, c.hint);
+            }
+            int i = _shapes[inst.shape].index_of(name);
+            c.shape = inst.shape;
+            c.hint = i == -1 ? kNoSlot : i;
+            c.next_shape = kNoShape;
+        }
+        return c.hint == kNoSlot ? nullptr : &inst.slot(c.hint);
+    }
+    c.shape = kNoShape;     // `hint` is a NameDict slot from here on
+    if(obj->is_attr_valid()) return obj->attr().try_get_hinted(name, c.hint);
+    return nullptr;
+}
+
+// returns false if the object cannot have attributes
+bool VM::_set_own_attr(const PyVar& obj, StrName name, PyVar value, InlineCache* c){
+    if(obj.is_tagged()) return false;
+    if(obj->has_shape()){
+        DummyInstance& inst = OBJ_GET(DummyInstance, obj);
+        if(c != nullptr && inst.shape == c->shape && c->next_shape != kNoShape){
+            if(c->next_shape != inst.shape){
+                inst.reserve(c->hint + 1);
+                inst.shape = c->next_shape;
+            }
+            inst.slot(c->hint) = std::move(value);
+            return true;
+        }
+        if(inst.is_dict_mode()){
+            inst._dict->set(name, std::move(value));
+            return true;
+        }
+        uint32_t from = inst.shape;
+        const Shape& shape = _shapes[from];
+        int i = shape.index_of(name);
+        if(i == -1){
+            uint32_t next = _shapes.add_name(from, name);
+            if(next == kDictShape){
+                inst._to_dict_mode(*shape.names, shape.size);
+                inst._dict->set(name, std::move(value));
+                return true;
+            }
+            i = shape.size;
+            inst.reserve(i + 1);
+            inst.shape = next;
+        }
+        inst.slot(i) = std::move(value);
+        if(c != nullptr){
+            c->shape = from;
+            c->next_shape = inst.shape;
+            c->hint = i;
+        }
+        return true;
+    }
+    if(!obj->is_attr_valid()) return false;
+    obj->attr().set(name, std::move(value));
+    return true;
+}
+
+// returns false if the object has no attribute `name`
+bool VM::_del_own_attr(const PyVar& obj, StrName name){
+    if(obj.is_tagged()) return false;
+    if(obj->has_shape()){
+        // instances that lose attributes tend to keep changing, so they leave the shape tree
+        DummyInstance& inst = OBJ_GET(DummyInstance, obj);
+        if(!inst.is_dict_mode()){
+            const Shape& shape = _shapes[inst.shape];
+            if(shape.index_of(name) == -1) return false;
+            inst._to_dict_mode(*shape.names, shape.size);
+        }
+        if(!inst._dict->contains(name)) return false;
+        inst._dict->erase(name);
+        return true;
+    }
+    if(!obj->is_attr_valid() || !obj->attr().contains(name)) return false;
+    obj->attr().erase(name);
+    return true;
+}
+
+void VM::delattr(const PyVar& obj, StrName name){
+    if(obj.is_tagged() || !(obj->has_shape() || obj->is_attr_valid())) TypeError("cannot delete attribute");
+    if(!_del_own_attr(obj, name)) AttributeError(obj, name);
+}
+
+std::vector<StrName> VM::_own_attr_names(const PyVar& obj){
+    if(obj.is_tagged()) return {};
+    if(obj->has_shape()){
+        const DummyInstance& inst = OBJ_GET(DummyInstance, obj);
+        if(inst.is_dict_mode()) return inst._dict->keys();
+        const Shape& shape = _shapes[inst.shape];
+        return std::vector<StrName>(shape.names->begin(), shape.names->begin() + shape.size);
+    }
+    if(obj->is_attr_valid()) return obj->attr().keys();
+    return {};
+}
+
+// same as setattr() but remembers the shape transition of instances; a data descriptor on
+// the class always takes the generic path
+void VM::setattr(const PyVar& obj, StrName name, PyVar value, InlineCache& c){
+    PyObject* objtype = _t(obj).get();
+    if(c.key != objtype || c.version != objtype->attr()._version){
+        if(is_type(obj, tp_super)){
+            PyVar tmp = obj;
+            setattr(&tmp, name, std::move(value));
+            return;
+        }
+        _update_attr_cache(objtype, name, c);
+        c.shape = kNoShape;
+    }
+    if(c.kind == CACHE_ATTR_DESCRIPTOR){
+        PyVar tmp = obj;
+        setattr(&tmp, name, std::move(value));
+        return;
+    }
+    if(!_set_own_attr(obj, name, std::move(value), &c)) TypeError("cannot set attribute");
 }
 
 template<int ARGC>
-void VM::bind_method(PyVar obj, Str name, NativeFuncRaw fn) {
+void VM::bind_method(PyVar obj, Str name, NativeFuncRaw fn, NativeKwargs kwargs) {
     check_type(obj, tp_type);
-    obj->attr().set(name, VAR(NativeFunc(fn, ARGC, true)));
+    obj->attr().set(name, VAR(NativeFunc(fn, ARGC, true, std::move(kwargs))));
 }
 
 template<int ARGC>
-void VM::bind_func(PyVar obj, Str name, NativeFuncRaw fn) {
-    obj->attr().set(name, VAR(NativeFunc(fn, ARGC, false)));
+void VM::bind_func(PyVar obj, Str name, NativeFuncRaw fn, NativeKwargs kwargs) {
+    obj->attr().set(name, VAR(NativeFunc(fn, ARGC, false, std::move(kwargs))));
 }
 
 void VM::_error(Exception e){
@@ -913,40 +1318,49 @@ PyVar VM::_exec(){
     Frame* frame = top_frame();
     i64 base_id = frame->id;
     PyVar ret = nullptr;
-    bool need_raise = false;
 
     while(true){
         if(frame->id < base_id) UNREACHABLE();
+        // C++ exceptions only carry errors raised inside native code back to this loop
         try{
-            if(need_raise){ need_raise = false; _raise(); }
             ret = run_frame(frame);
-            if(ret == _py_op_yield) return _py_op_yield;
-            if(ret != _py_op_call){
-                if(frame->id == base_id){      // [ frameBase<- ]
-                    callstack.pop();
-                    return ret;
-                }else{
-                    callstack.pop();
-                    frame = callstack.top().get();
-                    frame->push(ret);
-                }
-            }else{
-                frame = callstack.top().get();  // [ frameBase, newFrame<- ]
-            }
         }catch(HandledException& e){
             continue;
         }catch(UnhandledException& e){
-            PyVar obj = frame->pop();
-            Exception& _e = CAST(Exception&, obj);
-            _e.st_push(frame->snapshot());
-            callstack.pop();
-            if(callstack.empty()) throw _e;
-            frame = callstack.top().get();
-            frame->push(obj);
-            if(frame->id < base_id) throw ToBeRaisedException();
-            need_raise = true;
+            ret = _py_op_raise;
         }catch(ToBeRaisedException& e){
-            need_raise = true;
+            // the exception left a nested _exec() and is on top of the stack of `frame`
+            if(frame->jump_to_exception_handler()) continue;
+            ret = _py_op_raise;
+        }
+
+        if(ret == _py_op_raise){
+            // pass the exception on top of the stack to the callers until one handles it
+            do{
+                PyVar obj = frame->pop();
+                Exception& _e = CAST(Exception&, obj);
+                if(_e.st_size() < tracebacklimit) _e.st_push(frame->co->src, frame->curr_lineno());
+                callstack.pop();
+                if(callstack.empty()) throw _e;
+                frame = callstack.top().get();
+                frame->push(std::move(obj));
+                if(frame->id < base_id) throw ToBeRaisedException();
+            }while(!frame->jump_to_exception_handler());
+            continue;
+        }
+        if(ret == _py_op_yield) return _py_op_yield;
+        if(ret != _py_op_call){
+            if(frame->id == base_id){      // [ frameBase<- ]
+                callstack.pop();
+                return ret;
+            }else{
+                callstack.pop();
+                frame = callstack.top().get();
+                frame->push(std::move(ret));    // `ret` outlives the callee, it must not keep the value
+            }
+        }else{
+            frame = callstack.top().get();  // [ frameBase, newFrame<- ]
+            _gc.collect_if_pending();
         }
     }
 }
@@ -58,4 +58,21 @@ assert 7**21 == 558545864083284007
 assert 2**60 == 1152921504606846976
 assert -2**60 == -1152921504606846976
 assert 4**13 == 67108864
-assert (-4)**13 == -67108864
\ No newline at end of file
+assert (-4)**13 == -67108864
+assert 1 + 2.5 == 3.5
+assert 3 * 0.5 == 1.5
+assert 1 < 1.5 and 2 >= 2.0 and 1 == 1.0
+assert 7 / 2 == 3.5
+assert 6 & 3 == 2 and 6 | 3 == 7 and 6 ^ 3 == 5
+
+try:
+    a = 2**40 * 2**40
+    exit(1)
+except OverflowError:
+    pass
+
+try:
+    a = 1 % 0
+    exit(1)
+except ZeroDivisionError:
+    pass
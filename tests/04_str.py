@@ -14,12 +14,17 @@ assert len(a) == 0
 assert len(b) == 4
 assert b == c
 
-# upper and lower not work for utf-8
-# assert ''.lower() == '' and ''.upper() == ''
-# assert 'already+lower '.lower() == 'already+lower '
-# assert 'ALREADY+UPPER '.upper() == 'ALREADY+UPPER '
-# assert 'tEST+InG'.lower() == 'test+ing'
-# assert 'tEST+InG'.upper() == 'TEST+ING'
+assert ''.lower() == '' and ''.upper() == ''
+assert 'already+lower '.lower() == 'already+lower '
+assert 'ALREADY+UPPER '.upper() == 'ALREADY+UPPER '
+assert 'tEST+InG'.lower() == 'test+ing'
+assert 'tEST+InG'.upper() == 'TEST+ING'
+assert '测试abc'.upper() == '测试ABC'
+assert 'éÀœ ÿ'.upper() == 'ÉÀŒ Ÿ' and 'ÉÀŒ Ÿ'.lower() == 'éàœ ÿ'
+assert 'Привет, Ωμέγα'.upper() == 'ПРИВЕТ, ΩΜΈΓΑ'
+assert 'straße ﬁ'.upper() == 'STRASSE FI'
+assert 'İ'.lower() == 'i̇'
+assert 'ΟΔΟΣ ΣΑΣ.'.lower() == 'οδος σας.'
 
 s = "football"
 q = "abcd"
@@ -42,6 +47,17 @@ assert t.split('w') == ['this is string example....', 'o', '!!!']
 assert "a,b,c".split(',') == ['a', 'b', 'c']
 assert 'a,'.split(',') == ['a', '']
 assert 'foo!!bar!!baz'.split('!!') == ['foo', 'bar', 'baz']
+assert ' a  b\tc '.split() == ['a', 'b', 'c']
+assert 'a,b,c'.split(',', 1) == ['a', 'b,c']
+assert 'a,b,c'.rsplit(',', 1) == ['a,b', 'c']
+assert 'a\nb\r\nc'.splitlines() == ['a', 'b', 'c']
+# U+0085, U+2028 and U+2029 end lines too
+assert 'ab c d'.splitlines() == ['a', 'b', 'c', 'd']
+assert 'a b'.splitlines(True) == ['a ', 'b']
+assert 'k=v=w'.partition('=') == ('k', '=', 'v=w')
+assert '测试测试'.find('试', 2) == 3 and '测试测试'.rfind('测') == 2
+assert 'abcab'.index('b') == 1 and 'abcab'.count('ab') == 2
+assert 'aaa'.replace('a', 'b', 2) == 'bba'
 
 t = "*****this is **string** example....wow!!!*****"
 s = "123abcrunoob321"
@@ -75,4 +91,19 @@ assert str(num) == '6'
 # test Lo group names
 
 测试 = "test"
-assert 测试 == "test"
\ No newline at end of file
+assert 测试 == "test"
+# ascii strings index bytes directly, others by code point
+a = 'abc' * 10
+assert a[29] == 'c' and a[-1] == 'c' and a[3:6] == 'abc' and len(a) == 30
+b = 'a测c' * 10
+assert b[28] == '测' and b[3:6] == 'a测c' and len(b) == 30
+assert hash(a) == hash('abc' * 10)
+assert [c for c in 'ab测'] == ['a', 'b', '测']
+
+# strings over 64KB index by code point too
+b = '中文abc' * 20000
+assert len(b) == 100000
+assert b[99999] == 'c' and b[50000] == '中' and b[-4] == '文'
+assert b[70000:70005] == '中文abc'
+assert b.find('中', 99996) == -1 and b.rfind('文') == 99996
+assert sum([1 for c in b if c == '文']) == 20000
@@ -42,4 +42,59 @@ d1 = {1:2, 3:4}
 d2 = {3:4, 1:2}
 d3 = {1:2, 3:4, 5:6}
 assert d1 == d2
-assert d1 != d3
\ No newline at end of file
+assert d1 != d3
+# insertion order survives deletes and rehashing
+d = {}
+for i in range(100):
+    d[i] = i * 2
+for i in range(0, 100, 2):
+    del d[i]
+assert len(d) == 50
+assert list(d.keys())[:3] == [1, 3, 5]
+assert 2 not in d and d[99] == 198
+d[0] = 0
+assert list(d)[-1] == 0
+
+# views are lazy
+d = {'a': 1}
+keys = d.keys()
+d['b'] = 2
+assert len(keys) == 2
+assert 'b' in keys
+assert list(d.items()) == [('a', 1), ('b', 2)]
+assert repr(d.values()) == 'dict_values([1, 2])'
+
+assert dict([('x', 1), ['y', 2]]) == {'x': 1, 'y': 2}
+assert d.get('c') == None and d.get('c', 3) == 3
+assert {(1, 2): 'a'}[(1, 2)] == 'a'
+try:
+    x = d['c']
+    exit(1)
+except KeyError:
+    pass
+
+# an __eq__ that grows the dict during a lookup makes the lookup start over
+d = {(1, 2): 'a'}
+calls = []
+old_eq = tuple.__eq__
+def eq(a, b):
+    if len(calls) == 0:
+        calls.append(1)
+        for i in range(100):
+            d[i] = i
+    return old_eq(a, b)
+tuple.__eq__ = eq
+k = (1, 2)
+assert d[k] == 'a'
+tuple.__eq__ = old_eq
+assert len(calls) == 1 and len(d) == 101
+
+# a delete and an insert during iteration keep the size but are still caught
+d = {1: 1, 2: 2}
+try:
+    for k in d:
+        del d[2]
+        d[3] = 3
+    exit(1)
+except RuntimeError:
+    pass
@@ -76,4 +76,20 @@ assert type({}) is dict
 assert {1,2}.issubset({1,2,3})
 assert {1,2,3}.issuperset({1,2})
 assert {1,2,3}.isdisjoint({4,5,6})
-assert not {1,2,3}.isdisjoint({2,3,4})
\ No newline at end of file
+assert not {1,2,3}.isdisjoint({2,3,4})
+a = {1, 2}
+b = a
+a |= {3}
+assert b is a and b == {1, 2, 3}
+a -= {1}
+assert b is a and b == {2, 3}
+
+f = frozenset([1, 2, 3])
+d = {f: 1}
+assert d[frozenset([3, 2, 1])] == 1
+assert f == {1, 2, 3}
+assert type(f | {4}) is frozenset
+assert type({4} | f) is set
+assert repr(frozenset()) == 'frozenset()'
+assert {1, 2}.issubset([1, 2, 3])
+assert {1, 2, 3}.difference(range(2)) == {2, 3}
@@ -48,4 +48,41 @@ def f():
 
 f()
 assert a == 3
-assert b == 4
\ No newline at end of file
+assert b == 4
+# positional calls take their arguments in place, bound methods included
+class Counter:
+    def __init__(self):
+        self.n = 0
+    def add(self, k):
+        self.n += k
+        return self.n
+c = Counter()
+add = c.add
+assert add(2) == 2 and add(3) == 5
+items = []
+push = items.append
+push(1)
+push(add(1))
+assert items == [1, 6]
+assert max(*items) == 6
+
+def depth(n):
+    if n == 0:
+        return 0
+    return 1 + depth(n-1)
+assert depth(900) == 900
+try:
+    depth(100000)
+    exit(1)
+except RecursionError:
+    pass
+assert depth(10) == 10
+
+# frames whose operands do not fit in the rest of the value stack get a segment of their own
+def add2(a, b=0):
+    return a + b
+src = 'for i in range(10):\n    x = [' + ', '.join([str(i) for i in range(70000)]) + ', add2(i, 1), add2(i, b=1)]\n'
+exec(src)
+assert len(x) == 70002
+assert x[69999] == 69999
+assert x[70000] == 10 and x[70001] == 10
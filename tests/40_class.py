@@ -91,3 +91,131 @@ class B(A):
 # assert B.a == 1  ...bug here
 assert B.b == 3
 assert B.c == 4
+
+# attribute lookups are cached per instruction, changes to classes must be seen
+class P:
+    x = 1
+class Q(P):
+    pass
+def get_x(o):
+    return o.x
+q = Q()
+assert get_x(q) == 1
+P.x = 2
+assert get_x(q) == 2
+Q.x = 3
+assert get_x(q) == 3
+q.x = 4
+assert get_x(q) == 4
+Q.x = property(lambda self: 5)
+assert get_x(q) == 5
+
+def get_len():
+    return len
+assert get_len() is len
+len = 5
+assert get_len() == 5
+del len
+assert get_len()([1, 2]) == 2
+
+# method calls leave the function unbound unless the instance shadows it
+class M:
+    def f(self, x, y=1):
+        return x + y
+class N(M):
+    def f(self, x, y=1):
+        return M.f(self, x, y) * 2
+n = N()
+assert n.f(1) == 4
+assert n.f(1, y=2) == 6
+assert n.f(*[1, 3]) == 8
+assert super(N, n).f(1) == 2
+n.f = lambda x: x
+assert n.f(7) == 7
+
+# instances with the same attributes share a layout, adding or deleting one changes it
+class S:
+    def __init__(self, n):
+        for i in range(n):
+            setattr(self, 'a' + str(i), i)
+def get_a2(s):
+    return s.a2
+def set_a2(s, v):
+    s.a2 = v
+a = S(3)
+b = S(8)
+for _ in range(20):
+    assert get_a2(a) == 2
+    assert get_a2(b) == 2
+for i in range(8):
+    assert getattr(b, 'a' + str(i)) == i
+del b.a2
+assert not hasattr(b, 'a2')
+assert b.a3 == 3 and b.a7 == 7
+b.a2 = 'x'
+assert get_a2(b) == 'x'
+assert b.a7 == 7
+assert 'a2' in dir(b) and 'a7' in dir(b)
+c = S(0)
+for _ in range(20):
+    set_a2(c, 1)
+    set_a2(a, 1)
+    set_a2(b, 1)
+assert c.a2 == 1 and a.a2 == 1 and b.a2 == 1
+assert not hasattr(c, 'a0')
+try:
+    del c.a0
+    exit(1)
+except AttributeError:
+    pass
+
+# wide instances keep their attributes in a dict, cached lookups see both layouts
+w = S(40)
+for i in range(20):
+    assert get_a2(w) == 2 + i
+    assert get_a2(a) == 1 + i
+    set_a2(w, 3 + i)
+    set_a2(a, 2 + i)
+assert w.a2 == 22 and a.a2 == 21
+for i in range(40):
+    if i != 2:
+        assert getattr(w, 'a' + str(i)) == i
+assert len([k for k in dir(w) if k.startswith('a')]) == 40
+del w.a39
+assert not hasattr(w, 'a39')
+try:
+    del w.a39
+    exit(1)
+except AttributeError:
+    pass
+w.self = w
+w = None
+import gc
+gc.collect()
+
+# a class attribute written through a base class reaches cached lookups on subclasses
+class Base:
+    tag = 'base'
+    def who(self):
+        return 'base'
+class Derived(Base):
+    pass
+class Other:
+    count = 0
+d = Derived()
+def tag_of(x):
+    return x.tag
+def who(x):
+    return x.who()
+for _ in range(10):
+    assert tag_of(d) == 'base'
+    assert who(d) == 'base'
+    Other.count += 1
+assert Other.count == 10
+Base.tag = 'changed'
+Base.who = lambda self: 'changed'
+assert tag_of(d) == 'changed'
+assert who(d) == 'changed'
+Derived.tag = 'derived'
+assert tag_of(d) == 'derived'
+assert tag_of(Base()) == 'changed'
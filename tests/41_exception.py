@@ -53,3 +53,51 @@ try:
     exit(1)
 except AssertionError:
     pass
+
+def nested(n):
+    s = 0
+    for i in range(n):
+        try:
+            for j in range(3):
+                try:
+                    if j == 1:
+                        raise ValueError
+                    s += 1
+                except KeyError:
+                    s += 1000
+        except ValueError:
+            s += 10
+            try:
+                x = [][1]
+            except IndexError:
+                s += 100
+    return s
+assert nested(5) == 555
+
+def gen_with_try():
+    for i in range(3):
+        try:
+            yield i
+            raise KeyError
+        except KeyError:
+            pass
+assert list(gen_with_try()) == [0, 1, 2]
+
+def raise_if_even(i):
+    if i % 2 == 0:
+        raise KeyError
+    return i
+
+def count_raises(n):
+    c = 0
+    for i in range(n):
+        try:
+            raise_if_even(i)
+        except KeyError:
+            c += 1
+        try:
+            assert i < 0
+        except AssertionError:
+            c += 1
+    return c
+assert count_raises(10) == 15
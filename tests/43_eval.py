@@ -29,4 +29,12 @@ def f():
     exec(
         "exec('b = eval(\"3 + 5\")')"
     )
-    assert b == 8
\ No newline at end of file
+    assert b == 8
+def f(a, *c, b=2):
+    x = a + b
+    exec('x = x * 10')
+    y = eval('x + 1')
+    return x, y, c
+
+assert f(1) == (30, 31, tuple([]))
+assert f(1, 4, 5, b=3) == (40, 41, (4, 5))
@@ -4,4 +4,16 @@ def f(n):
 
 a = [i for i in f(6)]
 
-assert a == [0,1,2,3,4,5]
\ No newline at end of file
+assert a == [0,1,2,3,4,5]
+def pairs(n):
+    for i in range(n):
+        try:
+            yield [i, i*2]
+        except:
+            pass
+
+s = 0
+for a in pairs(5):
+    for b in pairs(3):
+        s += a[1] + b[0]
+assert s == 75
@@ -10,7 +10,10 @@ assert hasattr(int, '__add__')
 assert type(1).__add__(1, 2) == 3
 assert getattr(1, '__add__')(2) == 3
 
-a = {}
+class A:
+    pass
+
+a = A()
 setattr(a, 'b', 1)
 assert a.b == 1
 assert getattr(a, 'b') == 1
\ No newline at end of file
@@ -6,6 +6,55 @@ assert round(-23.8) == -24
 a = [1,2,3,-1]
 assert sorted(a) == [-1,1,2,3]
 assert sorted(a, reverse=True) == [3,2,1,-1]
+assert sorted(['bb', 'a', 'ccc'], key=len) == ['a', 'bb', 'ccc']
+assert sorted([2.5, 1, -3.0]) == [-3.0, 1, 2.5]
+
+# sort is stable, also in reverse
+pairs = [(1, 'b'), (0, 'x'), (1, 'a'), (0, 'y')]
+assert sorted(pairs, key=lambda p: p[0]) == [(0, 'x'), (0, 'y'), (1, 'b'), (1, 'a')]
+assert sorted(pairs, key=lambda p: p[0], reverse=True) == [(1, 'b'), (1, 'a'), (0, 'x'), (0, 'y')]
+
+calls = [0]
+def count_key(x):
+    calls[0] += 1
+    return -x
+b = list(range(100))
+b.sort(key=count_key)
+assert b == list(range(99, -1, -1)) and calls[0] == 100
+b.sort(reverse=True, key=None)
+assert b == list(range(99, -1, -1))
+b.sort()
+assert b == list(range(100))
+assert sorted((3, 1, 2)) == [1, 2, 3]
+assert sorted('bca') == ['a', 'b', 'c']
+
+# the list is empty while the key runs, changes to it are an error
+c = [3, 1, 2]
+def seen_len(x):
+    calls.append(len(c))
+    return x
+calls = []
+c.sort(key=seen_len)
+assert c == [1, 2, 3] and calls == [0, 0, 0]
+def grow(x):
+    c.append(x)
+    return x
+try:
+    c.sort(key=grow)
+    exit(1)
+except ValueError:
+    pass
+assert c == [1, 2, 3]
+def fail(x):
+    if x == 2:
+        raise KeyError(x)
+    return -x
+try:
+    c.sort(key=fail)
+    exit(1)
+except KeyError:
+    pass
+assert c == [1, 2, 3]
 
 assert abs(0) == 0
 assert abs(1.0) == 1.0
@@ -26,4 +75,15 @@ assert not all([True, False])
 assert not all([False, False])
 
 assert list(enumerate([1,2,3])) == [(0,1), (1,2), (2,3)]
-assert list(enumerate([1,2,3], 1)) == [(1,1), (2,2), (3,3)]
\ No newline at end of file
+assert list(enumerate([1,2,3], 1)) == [(1,1), (2,2), (3,3)]
+assert min([3, 1, 2]) == 1
+assert max(3, 1, 2) == 3
+assert max(['a', 'ccc', 'bb'], key=len) == 'ccc'
+assert min([], default=None) is None
+assert max([(1, 'a'), (1, 'b')], key=lambda p: p[0]) == (1, 'a')
+assert sum([1, 2, 3], 10) == 16
+assert sum([0.5, 0.5], start=1) == 2.0
+assert list(zip([1, 2, 3], 'ab', (5, 6, 7))) == [(1, 'a', 5), (2, 'b', 6)]
+assert list(map(lambda x, y: x + y, [1, 2], [10, 20])) == [11, 22]
+assert list(filter(None, [0, 1, '', 'a'])) == [1, 'a']
+assert list(enumerate('ab', start=5)) == [(5, 'a'), (6, 'b')]
@@ -0,0 +1,52 @@
+import gc
+
+assert gc.isenabled()
+gc.collect()
+
+class Node:
+    def __init__(self):
+        self.next = None
+
+# self and mutual references are freed by collect()
+a = Node()
+a.next = a
+b = Node()
+c = Node()
+b.next = c
+c.next = b
+del a, b, c
+assert gc.collect() >= 3
+
+l = []
+l.append(l)
+d = {}
+d['self'] = d
+del l, d
+assert gc.collect() >= 2
+
+# a function whose closure holds the function itself
+def outer():
+    def inner():
+        return inner
+    return inner
+f = outer()
+assert f() is f
+del f
+assert gc.collect() >= 1
+
+# live objects survive
+x = Node()
+x.next = [x, {1: x}]
+gc.collect()
+assert x.next[0] is x and x.next[1][1] is x
+
+gc.disable()
+assert not gc.isenabled()
+gc.enable()
+old = gc.get_threshold()
+gc.set_threshold(100, 5, 5)
+assert gc.get_threshold() == (100, 5, 5)
+gc.set_threshold(*old)
+assert len(gc.get_count()) == 3
+stats = gc.get_stats()
+assert len(stats) == 3 and stats[2]['collections'] >= 4
@@ -0,0 +1,56 @@
+import io
+
+f = io.StringIO()
+for i in range(5):
+    assert f.write(str(i)) == 1
+assert f.write('测试') == 2
+assert f.getvalue() == '01234测试'
+
+f = io.StringIO('ab')
+f.write('c')
+assert f.getvalue() == 'abc'
+f.close()
+try:
+    f.getvalue()
+    exit(1)
+except ValueError:
+    pass
+
+with io.StringIO(initial_value='x') as f:
+    f.write('y')
+    assert f.getvalue() == 'xy'
+
+# `s += x` on a variable nothing else refers to appends in place
+def build(n):
+    s = ''
+    for i in range(n):
+        s += 'ab'
+    return s
+assert build(1000) == 'ab' * 1000
+
+s = 'ab'
+t = s
+s += 'c'
+assert s == 'abc' and t == 'ab'
+a = ['x']
+b = a[0]
+b += 'y'
+assert a == ['x'] and b == 'xy'
+
+# literals are shared, so appending to one must copy it
+def greet():
+    s = 'hello'
+    s += '!'
+    return s
+assert greet() == 'hello!' and greet() == 'hello!'
+
+# a string used as an attribute name is interned, appending must drop that
+class A:
+    pass
+a = A()
+s = eval("'fo-o'")
+setattr(a, s, 0)
+s += 'x'
+setattr(a, s, 1)
+assert hasattr(a, 'fo-ox') and getattr(a, 'fo-ox') == 1
+assert getattr(a, 'fo-o') == 0
@@ -24,4 +24,78 @@ a %= 3
 assert a == 2
 
 a ^= 0xf0
-assert a == 242
\ No newline at end of file
+assert a == 242
+class A:
+    pass
+
+a = A()
+a.x = [1, 2, 3]
+a.x[0] += 10
+a.x[1] //= 2
+assert a.x == [11, 1, 3]
+a.y = 2
+a.y *= 3
+assert a.y == 6
+del a.y
+del a.x[0]
+assert a.x == [1, 3]
+
+x, y = [1, 2]
+x, y = y, x
+assert (x, y) == (2, 1)
+x, y = 'ab'
+assert (x, y) == ('a', 'b')
+
+try:
+    x, y = 1, 2, 3
+    exit(1)
+except ValueError:
+    pass
+
+# quickened instructions fall back to the generic form when operand types change
+def sub(x, y):
+    return x - y
+for i in range(20):
+    assert sub(i, 1) == i - 1
+assert sub(1.5, 1.0) == 0.5
+assert sub(2.5, 1) == 1.5
+
+def first(a):
+    return a[-1]
+for i in range(20):
+    assert first([i]) == i
+assert first('ab') == 'b'
+try:
+    first([])
+    exit(1)
+except IndexError:
+    pass
+
+fns = [sub] * 20 + [max]
+for f in fns:
+    assert f(3, 2) in [1, 3]
+
+import sys
+assert sys.gettracebacklimit() == 8
+sys.settracebacklimit(2)
+def deep_raise(n):
+    if n == 0:
+        raise ValueError
+    deep_raise(n-1)
+try:
+    deep_raise(20)
+    exit(1)
+except ValueError:
+    pass
+sys.settracebacklimit(8)
+
+# None, the bools, types and modules are immortal, references to them are not counted
+import sys
+n = sys.getrefcount(None)
+l = [None] * 100
+assert sys.getrefcount(None) == n
+assert sys.getrefcount(int) == sys.getrefcount(str)
+
+class _Sized:
+    pass
+assert sys.getsizeof(_Sized()) > sys.getsizeof([])